@@ -19,6 +19,7 @@
 #include "ArduinoJson/Variant/VariantRef.hpp"
 
 #include "ArduinoJson/Document/DynamicJsonDocument.hpp"
+#include "ArduinoJson/Document/JsonDocumentPool.hpp"
 #include "ArduinoJson/Document/StaticJsonDocument.hpp"
 
 #include "ArduinoJson/Array/ArrayImpl.hpp"
@@ -57,12 +58,24 @@ using ARDUINOJSON_NAMESPACE::deserializeJson;
 using ARDUINOJSON_NAMESPACE::deserializeMsgPack;
 using ARDUINOJSON_NAMESPACE::DynamicJsonDocument;
 using ARDUINOJSON_NAMESPACE::JsonDocument;
+using ARDUINOJSON_NAMESPACE::measureDeserializeJson;
+using ARDUINOJSON_NAMESPACE::measureDeserializeMsgPack;
 using ARDUINOJSON_NAMESPACE::serialized;
 using ARDUINOJSON_NAMESPACE::serializeJson;
 using ARDUINOJSON_NAMESPACE::serializeJsonPretty;
 using ARDUINOJSON_NAMESPACE::serializeMsgPack;
 using ARDUINOJSON_NAMESPACE::StaticJsonDocument;
 
+#if ARDUINOJSON_ENABLE_DOCUMENT_POOL
+using ARDUINOJSON_NAMESPACE::BasicJsonDocumentPool;
+using ARDUINOJSON_NAMESPACE::JsonDocumentPool;
+using ARDUINOJSON_NAMESPACE::PooledJsonDocument;
+#endif
+
+#if ARDUINOJSON_ENABLE_POOL_STATS
+using ARDUINOJSON_NAMESPACE::MemoryPoolStats;
+#endif
+
 namespace DeserializationOption {
 using ARDUINOJSON_NAMESPACE::NestingLimit;
 }
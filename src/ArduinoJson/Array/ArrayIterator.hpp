@@ -27,9 +27,10 @@ class VariantPtr {
 
 class ArrayIterator {
  public:
-  ArrayIterator() : _slot(0) {}
-  explicit ArrayIterator(MemoryPool *pool, VariantSlot *slot)
-      : _pool(pool), _slot(slot) {}
+  ArrayIterator() : _slot(0), _previous(0) {}
+  explicit ArrayIterator(MemoryPool *pool, VariantSlot *slot,
+                         VariantSlot *previous = 0)
+      : _pool(pool), _slot(slot), _previous(previous) {}
 
   VariantRef operator*() const {
     return VariantRef(_pool, _slot->data());
@@ -47,12 +48,13 @@ class ArrayIterator {
   }
 
   ArrayIterator &operator++() {
+    _previous = _slot;
     _slot = _slot->next();
     return *this;
   }
 
   ArrayIterator &operator+=(size_t distance) {
-    _slot = _slot->next(distance);
+    while (distance-- && _slot) ++*this;
     return *this;
   }
 
@@ -60,14 +62,21 @@ class ArrayIterator {
     return _slot;
   }
 
+  // The slot before internal(), or 0 if it's the first
+  VariantSlot *internalPrevious() {
+    return _previous;
+  }
+
  private:
   MemoryPool *_pool;
   VariantSlot *_slot;
+  VariantSlot *_previous;
 };
 
 class VariantConstPtr {
  public:
   VariantConstPtr(const VariantData *data) : _variant(data) {}
+  VariantConstPtr(const VariantConstRef &variant) : _variant(variant) {}
 
   VariantConstRef *operator->() {
     return &_variant;
@@ -83,30 +92,65 @@ class VariantConstPtr {
 
 class ArrayConstRefIterator {
  public:
-  ArrayConstRefIterator() : _slot(0) {}
-  explicit ArrayConstRefIterator(const VariantSlot *slot) : _slot(slot) {}
+  ArrayConstRefIterator() : _slot(0) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    _typedArray = 0;
+    _index = 0;
+#endif
+  }
+  explicit ArrayConstRefIterator(const VariantSlot *slot) : _slot(slot) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    _typedArray = 0;
+    _index = 0;
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  // Iterates the elements of a typed array, from the specified index
+  ArrayConstRefIterator(const VariantData *typedArray, size_t index)
+      : _slot(0), _typedArray(typedArray), _index(index) {
+    if (index >= typedArray->size()) *this = ArrayConstRefIterator();
+  }
+#endif
 
   VariantConstRef operator*() const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (_typedArray)
+      return VariantConstRef(_typedArray->asTypedArray(), _index);
+#endif
     return VariantConstRef(_slot->data());
   }
   VariantConstPtr operator->() {
-    return VariantConstPtr(_slot->data());
+    return VariantConstPtr(**this);
   }
 
   bool operator==(const ArrayConstRefIterator &other) const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (_typedArray != other._typedArray || _index != other._index)
+      return false;
+#endif
     return _slot == other._slot;
   }
 
   bool operator!=(const ArrayConstRefIterator &other) const {
-    return _slot != other._slot;
+    return !(*this == other);
   }
 
   ArrayConstRefIterator &operator++() {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (_typedArray) return *this += 1;
+#endif
     _slot = _slot->next();
     return *this;
   }
 
   ArrayConstRefIterator &operator+=(size_t distance) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (_typedArray) {
+      *this = ArrayConstRefIterator(_typedArray, _index + distance);
+      return *this;
+    }
+#endif
     _slot = _slot->next(distance);
     return *this;
   }
@@ -117,5 +161,9 @@ class ArrayConstRefIterator {
 
  private:
   const VariantSlot *_slot;
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  const VariantData *_typedArray;
+  size_t _index;
+#endif
 };
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -62,6 +62,9 @@ class ArrayConstRef : public ArrayRefBase<const CollectionData>,
   typedef ArrayConstRefIterator iterator;
 
   FORCE_INLINE iterator begin() const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (_typedArray) return iterator(_typedArray, 0);
+#endif
     if (!_data) return iterator();
     return iterator(_data->head());
   }
@@ -70,20 +73,83 @@ class ArrayConstRef : public ArrayRefBase<const CollectionData>,
     return iterator();
   }
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  FORCE_INLINE ArrayConstRef() : base_type(0), _typedArray(0) {}
+  FORCE_INLINE ArrayConstRef(const CollectionData* data)
+      : base_type(data), _typedArray(0) {}
+
+  // Reads the elements of a typed array in place, because converting it to a
+  // regular array would modify the document
+  FORCE_INLINE explicit ArrayConstRef(const VariantData& typedArray)
+      : base_type(0), _typedArray(&typedArray) {}
+
+  operator VariantConstRef() const {
+    return VariantConstRef(variant());
+  }
+
+  template <typename Visitor>
+  FORCE_INLINE void accept(Visitor& visitor) const {
+    if (_typedArray) return _typedArray->accept(visitor);
+    base_type::accept(visitor);
+  }
+
+  FORCE_INLINE bool isNull() const {
+    return !_typedArray && base_type::isNull();
+  }
+
+  FORCE_INLINE size_t memoryUsage() const {
+    if (_typedArray) return _typedArray->memoryUsage();
+    return base_type::memoryUsage();
+  }
+
+  FORCE_INLINE size_t nesting() const {
+    if (_typedArray) return _typedArray->nesting();
+    return base_type::nesting();
+  }
+
+  FORCE_INLINE size_t size() const {
+    if (_typedArray) return _typedArray->size();
+    return base_type::size();
+  }
+
+  FORCE_INLINE bool operator==(ArrayConstRef rhs) const {
+    if (_typedArray || rhs._typedArray)
+      return variantEquals(variant(), rhs.variant());
+    return arrayEquals(_data, rhs._data);
+  }
+#else
   FORCE_INLINE ArrayConstRef() : base_type(0) {}
   FORCE_INLINE ArrayConstRef(const CollectionData* data) : base_type(data) {}
 
   FORCE_INLINE bool operator==(ArrayConstRef rhs) const {
     return arrayEquals(_data, rhs._data);
   }
+#endif
 
   FORCE_INLINE VariantConstRef operator[](size_t index) const {
     return getElement(index);
   }
 
   FORCE_INLINE VariantConstRef getElement(size_t index) const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (_typedArray) {
+      if (index >= _typedArray->size()) return VariantConstRef();
+      return VariantConstRef(_typedArray->asTypedArray(), index);
+    }
+#endif
     return VariantConstRef(_data ? _data->get(index) : 0);
   }
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+ private:
+  const VariantData* variant() const {
+    if (_typedArray) return _typedArray;
+    const void* data = _data;  // prevent warning cast-align
+    return reinterpret_cast<const VariantData*>(data);
+  }
+
+  const VariantData* _typedArray;
+#endif
 };
 
 class ArrayRef : public ArrayRefBase<CollectionData>,
@@ -122,6 +188,9 @@ class ArrayRef : public ArrayRefBase<CollectionData>,
 
   // Copy a ArrayRef
   FORCE_INLINE bool set(ArrayConstRef src) const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (_data && src._typedArray) return copyElements(src);
+#endif
     if (!_data || !src._data) return false;
     return _data->copyFrom(*src._data, _pool);
   }
@@ -132,22 +201,46 @@ class ArrayRef : public ArrayRefBase<CollectionData>,
 
   // Gets the value at the specified index.
   FORCE_INLINE VariantRef getElement(size_t index) const {
-    return VariantRef(_pool, _data ? _data->get(index) : 0);
+    return VariantRef(_pool, _data ? _data->get(index, _pool) : 0);
   }
 
   // Removes element at specified position.
   FORCE_INLINE void remove(iterator it) const {
     if (!_data) return;
-    _data->remove(it.internal());
+    _data->remove(it.internal(), _pool);
+  }
+
+  // Removes element at specified position, and returns the position of the
+  // next one. Unlike remove(iterator), this doesn't search the previous
+  // element, provided that the iterator comes from begin(), operator++ or
+  // erase(), and that nothing was removed since.
+  FORCE_INLINE iterator erase(iterator it) const {
+    if (!_data || !it.internal()) return end();
+    VariantSlot* next = it.internal()->next();
+    _data->remove(it.internal(), it.internalPrevious(), _pool);
+    return iterator(_pool, next, it.internalPrevious());
   }
 
   // Removes element at specified index.
   FORCE_INLINE void remove(size_t index) const {
     if (!_data) return;
-    _data->remove(index);
+    _data->remove(index, _pool);
   }
 
  private:
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  bool copyElements(ArrayConstRef src) const {
+    // release the previous content once copied, because src may be part of it
+    CollectionData previous = *_data;
+    _data->clear();
+    bool ok = true;
+    for (ArrayConstRef::iterator it = src.begin(); ok && it != src.end(); ++it)
+      ok = add(*it);
+    previous.release(_pool);
+    return ok;
+  }
+#endif
+
   MemoryPool* _pool;
 };
 }  // namespace ARDUINOJSON_NAMESPACE
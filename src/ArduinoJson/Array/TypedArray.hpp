@@ -0,0 +1,155 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include "../Numbers/Float.hpp"
+#include "../Numbers/Integer.hpp"
+#include "../Polyfills/type_traits.hpp"
+
+#include <stdint.h>  // int8_t, int16_t, int32_t, int64_t
+#include <string.h>  // memcpy
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// The type of the elements of a typed array.
+// It's stored in the three lower bits of the variant's flags.
+enum TypedArrayType {
+  TYPED_ARRAY_INT8 = 0,
+  TYPED_ARRAY_INT16 = 1,
+  TYPED_ARRAY_INT32 = 2,
+  TYPED_ARRAY_INT64 = 3,
+  TYPED_ARRAY_FLOAT = 4,
+  TYPED_ARRAY_DOUBLE = 5,
+  TYPED_ARRAY_NONE = 7
+};
+
+// Tells the type of typed array that can hold values of type T
+template <typename T, typename Enable = void>
+struct TypedArrayTypeOf {
+  static const uint8_t value = TYPED_ARRAY_NONE;
+};
+
+// signed char, signed short, signed int, signed long, signed long long
+// (a plain char is a character, and its sign depends on the platform)
+template <typename T>
+struct TypedArrayTypeOf<
+    T, typename enable_if<is_integral<T>::value && is_signed<T>::value &&
+                          !is_same<T, char>::value &&
+                          sizeof(T) <= sizeof(Integer)>::type> {
+  static const uint8_t value =
+      sizeof(T) == 1 ? TYPED_ARRAY_INT8
+                     : sizeof(T) == 2 ? TYPED_ARRAY_INT16
+                                      : sizeof(T) == 4 ? TYPED_ARRAY_INT32
+                                                       : TYPED_ARRAY_INT64;
+};
+
+template <>
+struct TypedArrayTypeOf<float> {
+  static const uint8_t value = TYPED_ARRAY_FLOAT;
+};
+
+template <>
+struct TypedArrayTypeOf<double> {
+  static const uint8_t value = TYPED_ARRAY_DOUBLE;
+};
+
+// A read-only view of the elements of a typed array.
+// The elements are packed in the string zone of the MemoryPool, so they are
+// not aligned; they are read with memcpy().
+// (see ARDUINOJSON_ENABLE_TYPED_ARRAYS)
+class TypedArray {
+ public:
+  TypedArray(const char* data, size_t size, uint8_t type)
+      : _data(data), _size(size), _type(type) {}
+
+  const char* data() const {
+    return _data;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  uint8_t type() const {
+    return _type;
+  }
+
+  bool isFloat() const {
+    return _type >= TYPED_ARRAY_FLOAT;
+  }
+
+  // Number of bytes used by the elements
+  size_t memoryUsage() const {
+    return _size * elementSize(_type);
+  }
+
+  Integer integerAt(size_t index) const {
+    const char* p = _data + index * elementSize(_type);
+    switch (_type) {
+      case TYPED_ARRAY_INT8:
+        return read<int8_t, Integer>(p);
+      case TYPED_ARRAY_INT16:
+        return read<int16_t, Integer>(p);
+      case TYPED_ARRAY_INT32:
+        return read<int32_t, Integer>(p);
+      case TYPED_ARRAY_INT64:
+        return read<int64_t, Integer>(p);
+      case TYPED_ARRAY_FLOAT:
+        return read<float, Integer>(p);
+      default:
+        return read<double, Integer>(p);
+    }
+  }
+
+  Float floatAt(size_t index) const {
+    const char* p = _data + index * elementSize(_type);
+    switch (_type) {
+      case TYPED_ARRAY_FLOAT:
+        return read<float, Float>(p);
+      case TYPED_ARRAY_DOUBLE:
+        return read<double, Float>(p);
+      default:
+        return Float(integerAt(index));
+    }
+  }
+
+  template <typename Visitor>
+  void acceptElement(size_t index, Visitor& visitor) const {
+    if (isFloat()) return visitor.visitFloat(floatAt(index));
+    Integer value = integerAt(index);
+    if (value < 0)
+      visitor.visitNegativeInteger(UInt(0) - UInt(value));
+    else
+      visitor.visitPositiveInteger(UInt(value));
+  }
+
+  static size_t elementSize(uint8_t type) {
+    switch (type) {
+      case TYPED_ARRAY_INT8:
+        return 1;
+      case TYPED_ARRAY_INT16:
+        return 2;
+      case TYPED_ARRAY_INT32:
+      case TYPED_ARRAY_FLOAT:
+        return 4;
+      default:
+        return 8;
+    }
+  }
+
+ private:
+  template <typename TElement, typename TValue>
+  static TValue read(const char* p) {
+    TElement element;
+    memcpy(&element, p, sizeof(TElement));
+    return TValue(element);
+  }
+
+  const char* _data;
+  size_t _size;
+  uint8_t _type;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
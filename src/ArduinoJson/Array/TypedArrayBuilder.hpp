@@ -0,0 +1,147 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include "../Memory/MemoryPool.hpp"
+#include "../Numbers/parseNumber.hpp"
+#include "../Polyfills/limits.hpp"
+#include "TypedArray.hpp"
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Collects the numbers of an array in the string zone of the MemoryPool.
+// Like StringBuilder, it takes all the free space until complete() is called.
+// The numbers are either all integers or all floats, so that each one reads
+// back with its original type; they are packed in the smallest type that holds
+// them all.
+class TypedArrayBuilder {
+  union Cell {
+    Integer asInteger;
+    Float asFloat;
+  };
+
+ public:
+  // Number of bytes taken by each number until complete() is called
+  static const size_t cellSize = sizeof(Cell);
+
+  explicit TypedArrayBuilder(MemoryPool* pool)
+      : _pool(pool), _size(0), _isFloat(false), _lowest(0), _highest(0) {
+    _slot = _pool->allocExpandableString();
+  }
+
+  // Tells if the number can be stored without loss, next to the numbers
+  // already appended
+  bool canStore(const ParsedNumber<Float, UInt>& number) const {
+    return canStore(number, _size, _isFloat);
+  }
+
+  // An integer after a float, or a float after an integer, would read back
+  // with another type
+  static bool canStore(const ParsedNumber<Float, UInt>& number, size_t size,
+                       bool isFloat) {
+    if (number.type() == VALUE_IS_FLOAT) return size == 0 || isFloat;
+    return !isFloat &&
+           number.uintValue <= UInt(numeric_limits<Integer>::highest());
+  }
+
+  // Returns false if the pool is full
+  bool append(const ParsedNumber<Float, UInt>& number) {
+    ARDUINOJSON_ASSERT(canStore(number));
+    if (!_slot.value) return false;
+
+    // the packed numbers take at most stringSize() of the cells
+    size_t required = MemoryPool::stringSize((_size + 1) * sizeof(Cell));
+    if (required > _slot.size &&
+        !_pool->growExpandableString(_slot, _size * sizeof(Cell))) {
+      _slot.value = 0;
+      return false;
+    }
+
+    Cell cell;
+    if (number.type() == VALUE_IS_FLOAT) {
+      _isFloat = true;
+      cell.asFloat = number.floatValue;
+    } else {
+      Integer value = number.type() == VALUE_IS_NEGATIVE_INTEGER
+                          ? -Integer(number.uintValue)
+                          : Integer(number.uintValue);
+      updateRange(value);
+      cell.asInteger = value;
+    }
+    write(_size++, cell);
+    return true;
+  }
+
+  // Packs the numbers and gives the unused space back to the pool
+  TypedArray complete() {
+    ARDUINOJSON_ASSERT(_slot.value != 0);
+    uint8_t type = elementType();
+    size_t n = TypedArray::elementSize(type);
+    for (size_t i = 0; i < _size; i++) {
+      Cell cell = read(i);
+      char* p = _slot.value + i * n;
+      switch (type) {
+        case TYPED_ARRAY_INT8:
+          pack<int8_t>(p, cell.asInteger);
+          break;
+        case TYPED_ARRAY_INT16:
+          pack<int16_t>(p, cell.asInteger);
+          break;
+        case TYPED_ARRAY_INT32:
+          pack<int32_t>(p, cell.asInteger);
+          break;
+        case TYPED_ARRAY_INT64:
+          pack<int64_t>(p, cell.asInteger);
+          break;
+        default:
+          pack<Float>(p, cell.asFloat);
+          break;
+      }
+    }
+    _pool->freezeString(_slot, MemoryPool::stringSize(_size * n));
+    return TypedArray(_slot.value, _size, type);
+  }
+
+ private:
+  uint8_t elementType() const {
+    if (_isFloat) return TypedArrayTypeOf<Float>::value;
+    if (_lowest >= -0x80 && _highest <= 0x7F) return TYPED_ARRAY_INT8;
+    if (_lowest >= -0x8000 && _highest <= 0x7FFF) return TYPED_ARRAY_INT16;
+    if (_lowest >= -Integer(0x7FFFFFFF) - 1 &&
+        _highest <= Integer(0x7FFFFFFF))
+      return TYPED_ARRAY_INT32;
+    return TYPED_ARRAY_INT64;
+  }
+
+  void updateRange(Integer value) {
+    if (_size == 0 || value < _lowest) _lowest = value;
+    if (_size == 0 || value > _highest) _highest = value;
+  }
+
+  // The cells are not aligned, see TypedArray
+  Cell read(size_t index) const {
+    Cell cell;
+    memcpy(&cell, _slot.value + index * sizeof(Cell), sizeof(Cell));
+    return cell;
+  }
+
+  void write(size_t index, const Cell& cell) {
+    memcpy(_slot.value + index * sizeof(Cell), &cell, sizeof(Cell));
+  }
+
+  template <typename TElement, typename TValue>
+  static void pack(char* p, TValue value) {
+    TElement element = TElement(value);
+    memcpy(p, &element, sizeof(TElement));
+  }
+
+  MemoryPool* _pool;
+  StringSlot _slot;
+  size_t _size;
+  bool _isFloat;
+  Integer _lowest, _highest;
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
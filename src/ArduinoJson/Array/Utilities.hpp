@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../Document/JsonDocument.hpp"
 #include "ArrayRef.hpp"
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -24,6 +25,39 @@ inline bool copyArray(T* src, size_t len, ArrayRef dst) {
   return ok;
 }
 
+// Copy a 1D array to a JsonVariant
+// (an array of numbers becomes a typed array, see
+// ARDUINOJSON_ENABLE_TYPED_ARRAYS)
+template <typename T, size_t N>
+inline bool copyArray(T (&src)[N], VariantRef dst) {
+  return copyArray(src, N, dst);
+}
+
+// Copy a 1D array to a JsonVariant
+template <typename T>
+inline bool copyArray(T* src, size_t len, VariantRef dst) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  const uint8_t type = TypedArrayTypeOf<T>::value;
+  if (type != TYPED_ARRAY_NONE) {
+    const void* data = src;
+    return dst.set(TypedArray(static_cast<const char*>(data), len, type));
+  }
+#endif
+  return copyArray(src, len, dst.to<ArrayRef>());
+}
+
+// Copy a 1D array to a JsonDocument
+template <typename T, size_t N>
+inline bool copyArray(T (&src)[N], JsonDocument& dst) {
+  return copyArray(src, N, dst.to<VariantRef>());
+}
+
+// Copy a 1D array to a JsonDocument
+template <typename T>
+inline bool copyArray(T* src, size_t len, JsonDocument& dst) {
+  return copyArray(src, len, dst.to<VariantRef>());
+}
+
 // Copy a 2D array to a JsonArray
 template <typename T, size_t N1, size_t N2>
 inline bool copyArray(T (&src)[N1][N2], ArrayRef dst) {
@@ -53,14 +87,106 @@ inline size_t copyArray(ArrayConstRef src, T* dst, size_t len) {
   return i;
 }
 
+// Copy a JsonArray to a 1D array
+// (needed because ArrayRef converts to ArrayConstRef and VariantConstRef)
+template <typename T, size_t N>
+inline size_t copyArray(ArrayRef src, T (&dst)[N]) {
+  return copyArray(ArrayConstRef(src), dst, N);
+}
+
+// Copy a JsonArray to a 1D array
+template <typename T>
+inline size_t copyArray(ArrayRef src, T* dst, size_t len) {
+  return copyArray(ArrayConstRef(src), dst, len);
+}
+
+// Copies the elements of an array, or of a typed array, to a 1D array
+template <typename T>
+class ArrayCopier {
+ public:
+  ArrayCopier(T* dst, size_t len) : _dst(dst), _len(len), _count(0) {}
+
+  size_t count() const {
+    return _count;
+  }
+
+  void visitArray(const CollectionData& array) {
+    _count = copyArray(ArrayConstRef(&array), _dst, _len);
+  }
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  void visitTypedArray(const TypedArray& array) {
+    _count = array.size() < _len ? array.size() : _len;
+    if (TypedArrayTypeOf<T>::value == array.type()) {
+      void* dst = _dst;
+      memcpy(dst, array.data(), _count * sizeof(T));
+      return;
+    }
+    for (size_t i = 0; i < _count; i++) {
+      VariantData element = VariantData();
+      element.setTypedArrayElement(array, i);
+      _dst[i] = VariantConstRef(&element).as<T>();
+    }
+  }
+#endif
+
+  void visitObject(const CollectionData&) {}
+  void visitFloat(Float) {}
+  void visitString(const char*) {}
+  void visitString(const char*, size_t) {}
+  void visitRawJson(const char*, size_t) {}
+  void visitNegativeInteger(UInt) {}
+  void visitPositiveInteger(UInt) {}
+  void visitBoolean(bool) {}
+  void visitNull() {}
+
+ private:
+  T* _dst;
+  size_t _len;
+  size_t _count;
+};
+
+// Copy a JsonVariant to a 1D array
+// (this one also reads typed arrays, see ARDUINOJSON_ENABLE_TYPED_ARRAYS)
+template <typename T, size_t N>
+inline size_t copyArray(VariantConstRef src, T (&dst)[N]) {
+  return copyArray(src, dst, N);
+}
+
+// Copy a JsonVariant to a 1D array
+template <typename T>
+inline size_t copyArray(VariantConstRef src, T* dst, size_t len) {
+  ArrayCopier<T> copier(dst, len);
+  src.accept(copier);
+  return copier.count();
+}
+
+// Copy a JsonDocument to a 1D array
+template <typename T, size_t N>
+inline size_t copyArray(const JsonDocument& src, T (&dst)[N]) {
+  return copyArray(src.as<VariantConstRef>(), dst, N);
+}
+
+// Copy a JsonDocument to a 1D array
+template <typename T>
+inline size_t copyArray(const JsonDocument& src, T* dst, size_t len) {
+  return copyArray(src.as<VariantConstRef>(), dst, len);
+}
+
 // Copy a JsonArray to a 2D array
 template <typename T, size_t N1, size_t N2>
 inline void copyArray(ArrayConstRef src, T (&dst)[N1][N2]) {
   size_t i = 0;
   for (ArrayConstRef::iterator it = src.begin(); it != src.end() && i < N1;
        ++it) {
-    copyArray(it->as<ArrayConstRef>(), dst[i++]);
+    copyArray(*it, dst[i++]);
   }
 }
 
+// Copy a JsonArray to a 2D array
+template <typename T, size_t N1, size_t N2>
+inline void copyArray(ArrayRef src, T (&dst)[N1][N2]) {
+  copyArray(ArrayConstRef(src), dst);
+}
+
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -4,15 +4,30 @@
 
 #pragma once
 
+#include "../Configuration.hpp"
+
+#include <stddef.h>  // size_t
+
+#define ARDUINOJSON_ENABLE_COLLECTION_INDEX \
+  (ARDUINOJSON_ENABLE_OBJECT_INDEX || ARDUINOJSON_ENABLE_ARRAY_INDEX)
+
 namespace ARDUINOJSON_NAMESPACE {
 
 class MemoryPool;
 class VariantData;
 class VariantSlot;
+struct CollectionIndex;
+struct MemoryPoolMove;
 
 class CollectionData {
   VariantSlot *_head;
   VariantSlot *_tail;
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  size_t _size;
+#endif
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  CollectionIndex *_index;
+#endif
 
  public:
   // Must be a POD!
@@ -39,32 +54,56 @@ class CollectionData {
 
   VariantData *get(size_t index) const;
 
+  // Same as above, but can also create or update the index
+  // (see ARDUINOJSON_ENABLE_ARRAY_INDEX)
+  VariantData *get(size_t index, MemoryPool *pool);
+
   template <typename TAdaptedString>
   VariantData *get(TAdaptedString key) const;
 
+  // Same as above, but can also create or update the index
+  // (see ARDUINOJSON_ENABLE_OBJECT_INDEX)
+  template <typename TAdaptedString>
+  VariantData *get(TAdaptedString key, MemoryPool *pool);
+
   VariantSlot *head() const {
     return _head;
   }
 
-  void remove(size_t index);
+  // Updates the pointers to the pool, after MemoryPool::squashTo()
+  void movePointers(const MemoryPoolMove &move);
+
+  void release(MemoryPool *pool);
+
+  void remove(size_t index, MemoryPool *pool);
 
   template <typename TAdaptedString>
-  void remove(TAdaptedString key) {
-    remove(getSlot(key));
-  }
+  void remove(TAdaptedString key, MemoryPool *pool);
 
-  void remove(VariantSlot *slot);
+  void remove(VariantSlot *slot, MemoryPool *pool);
+
+  // Same as above, when the previous slot is known (0 for the head)
+  void remove(VariantSlot *slot, VariantSlot *previous, MemoryPool *pool);
 
   size_t memoryUsage() const;
   size_t nesting() const;
   size_t size() const;
 
  private:
+  bool copyElementsFrom(const CollectionData &src, MemoryPool *pool);
+
   VariantSlot *getSlot(size_t index) const;
 
   template <typename TAdaptedString>
   VariantSlot *getSlot(TAdaptedString key) const;
 
   VariantSlot *getPreviousSlot(VariantSlot *) const;
+
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  void indexMembers(MemoryPool *pool);
+#endif
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  void indexElements(MemoryPool *pool);
+#endif
 };
 }  // namespace ARDUINOJSON_NAMESPACE
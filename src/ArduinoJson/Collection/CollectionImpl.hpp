@@ -6,6 +6,8 @@
 
 #include "../Variant/VariantData.hpp"
 #include "CollectionData.hpp"
+#include "CollectionIndex.hpp"
+#include "KeyMatcher.hpp"
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -20,6 +22,9 @@ inline VariantSlot* CollectionData::addSlot(MemoryPool* pool) {
     _head = slot;
     _tail = slot;
   }
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  _size++;
+#endif
 
   slot->clear();
   return slot;
@@ -39,6 +44,12 @@ inline VariantData* CollectionData::add(TAdaptedString key, MemoryPool* pool) {
 inline void CollectionData::clear() {
   _head = 0;
   _tail = 0;
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  _size = 0;
+#endif
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  _index = 0;
+#endif
 }
 
 template <typename TAdaptedString>
@@ -48,6 +59,22 @@ inline bool CollectionData::containsKey(const TAdaptedString& key) const {
 
 inline bool CollectionData::copyFrom(const CollectionData& src,
                                      MemoryPool* pool) {
+  // release the previous content once copied, because src may be part of it
+  CollectionData previous = *this;
+  bool ok = copyElementsFrom(src, pool);
+  previous.release(pool);
+  // keep the lookups fast in the copy, as in the source
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  if (ok && src._index && !src._index->isArray) indexMembers(pool);
+#endif
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  if (ok && src._index && src._index->isArray) indexElements(pool);
+#endif
+  return ok;
+}
+
+inline bool CollectionData::copyElementsFrom(const CollectionData& src,
+                                             MemoryPool* pool) {
   clear();
   for (VariantSlot* s = src._head; s; s = s->next()) {
     VariantData* var;
@@ -91,18 +118,32 @@ inline bool CollectionData::equalsArray(const CollectionData& other) const {
 template <typename TAdaptedString>
 inline VariantSlot* CollectionData::getSlot(TAdaptedString key) const {
   VariantSlot* slot = _head;
-  while (slot) {
-    if (key.equals(slot->key())) break;
-    slot = slot->next();
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  if (_index && key.data()) {
+    slot = _index->find(key);
+    if (slot) return slot;
+    // the members after the last indexed one are not in the index yet
+    slot = _index->last ? _index->last->next() : _head;
   }
+#endif
+  KeyMatcher<TAdaptedString> matcher(key);
+  while (slot && !matcher.matches(slot)) slot = slot->next();
   return slot;
 }
 
 inline VariantSlot* CollectionData::getSlot(size_t index) const {
-  return _head->next(index);
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  if (_index && _index->isArray && _index->count) {
+    if (index < _index->count) return _index->at(index);
+    // the elements after the last indexed one are not in the index yet
+    return _index->last->next(index - _index->count + 1);
+  }
+#endif
+  return _head ? _head->next(index) : 0;
 }
 
 inline VariantSlot* CollectionData::getPreviousSlot(VariantSlot* target) const {
+  if (target == _head) return 0;
   VariantSlot* current = _head;
   while (current) {
     VariantSlot* next = current->next();
@@ -118,25 +159,186 @@ inline VariantData* CollectionData::get(TAdaptedString key) const {
   return slot ? slot->data() : 0;
 }
 
+template <typename TAdaptedString>
+inline VariantData* CollectionData::get(TAdaptedString key, MemoryPool* pool) {
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+  if (!_index && key.data()) {
+    // create the index only when the member is far from the head
+    KeyMatcher<TAdaptedString> matcher(key);
+    size_t distance = 0;
+    VariantSlot* slot = _head;
+    while (slot && !matcher.matches(slot)) {
+      slot = slot->next();
+      distance++;
+    }
+    if (distance >= ARDUINOJSON_OBJECT_INDEX_THRESHOLD) indexMembers(pool);
+    return slotData(slot);
+  }
+  if (_index) indexMembers(pool);
+#else
+  (void)pool;
+#endif
+  return get(key);
+}
+
 inline VariantData* CollectionData::get(size_t index) const {
   VariantSlot* slot = getSlot(index);
   return slot ? slot->data() : 0;
 }
 
-inline void CollectionData::remove(VariantSlot* slot) {
+inline VariantData* CollectionData::get(size_t index, MemoryPool* pool) {
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  // extend the index only when the element is far from the indexed ones
+  size_t indexed = _index ? _index->count : 0;
+  if (index >= indexed + ARDUINOJSON_ARRAY_INDEX_THRESHOLD &&
+      getSlot(indexed + ARDUINOJSON_ARRAY_INDEX_THRESHOLD))
+    indexElements(pool);
+#else
+  (void)pool;
+#endif
+  return get(index);
+}
+
+inline void CollectionData::movePointers(const MemoryPoolMove& move) {
+  _head = move.relocate(_head);
+  _tail = move.relocate(_tail);
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  _index = move.relocate(_index);
+  if (_index) _index->movePointers(move);
+#endif
+  for (VariantSlot* slot = _head; slot; slot = slot->next()) {
+    slot->relocateKey(move);
+    slot->data()->movePointers(move);
+  }
+}
+
+inline void CollectionData::release(MemoryPool* pool) {
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  if (_index) _index->release(pool);
+#endif
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  VariantSlot* slot = _head;
+  while (slot) {
+    VariantSlot* next = slot->next();
+    slotRelease(slot, pool);
+    slot = next;
+  }
+#else
+  (void)pool;
+#endif
+}
+
+inline void CollectionData::remove(VariantSlot* slot, MemoryPool* pool) {
+  if (!slot) return;
+  remove(slot, getPreviousSlot(slot), pool);
+}
+
+inline void CollectionData::remove(VariantSlot* slot, VariantSlot* previous,
+                                   MemoryPool* pool) {
   if (!slot) return;
-  VariantSlot* prev = getPreviousSlot(slot);
+  ARDUINOJSON_ASSERT(previous ? previous->next() == slot : slot == _head);
+#if ARDUINOJSON_ENABLE_COLLECTION_INDEX
+  if (_index) _index->erase(slot, previous);
+#endif
   VariantSlot* next = slot->next();
-  if (prev)
-    prev->setNext(next);
+  if (previous)
+    previous->setNext(next);
   else
     _head = next;
-  if (!next) _tail = prev;
+  if (!next) _tail = previous;
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  _size--;
+#endif
+  slotRelease(slot, pool);
+}
+
+inline void CollectionData::remove(size_t index, MemoryPool* pool) {
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+  if (_index && index < _index->count) {
+    VariantSlot* slot = _index->at(index);
+    VariantSlot* previous = index ? _index->at(index - 1) : 0;
+    // the elements before are still at the same position
+    _index->truncate(index);
+    remove(slot, previous, pool);
+    return;
+  }
+#endif
+  VariantSlot* previous = 0;
+  VariantSlot* slot = _head;
+  while (slot && index--) {
+    previous = slot;
+    slot = slot->next();
+  }
+  remove(slot, previous, pool);
 }
 
-inline void CollectionData::remove(size_t index) {
-  remove(getSlot(index));
+template <typename TAdaptedString>
+inline void CollectionData::remove(TAdaptedString key, MemoryPool* pool) {
+  KeyMatcher<TAdaptedString> matcher(key);
+  VariantSlot* previous = 0;
+  VariantSlot* slot = _head;
+  while (slot && !matcher.matches(slot)) {
+    previous = slot;
+    slot = slot->next();
+  }
+  remove(slot, previous, pool);
+}
+
+#if ARDUINOJSON_ENABLE_OBJECT_INDEX
+// Adds the members that are not in the index yet.
+// If the pool is full, the remaining members stay out of the index, and the
+// lookups fall back to comparing their keys.
+inline void CollectionData::indexMembers(MemoryPool* pool) {
+  VariantSlot* slot = _head;
+  if (_index && _index->last) slot = _index->last->next();
+  while (slot) {
+    if (!_index || _index->isFull()) {
+      // make room for all the members at once, to rebuild only once
+      size_t count = slotSize(_head);
+      size_t capa = _index ? 2 * _index->capacity : 8;
+      while (capa < 2 * ARDUINOJSON_OBJECT_INDEX_THRESHOLD) capa *= 2;
+      while (4 * (count + 1) > 3 * capa) capa *= 2;
+      CollectionIndex* index =
+          _index ? _index->resize(capa, pool)
+                 : CollectionIndex::create(capa, false, pool);
+      if (!index) return;
+      _index = index;
+      // index from the head, so that duplicate keys stay in order
+      _index->reset();
+      slot = _head;
+    }
+    _index->insert(slot);
+    _index->last = slot;
+    slot = slot->next();
+  }
+}
+#endif
+
+#if ARDUINOJSON_ENABLE_ARRAY_INDEX
+// Appends the elements that are not in the index yet.
+// If the pool is full, the remaining elements stay out of the index, and the
+// lookups fall back to following the links.
+inline void CollectionData::indexElements(MemoryPool* pool) {
+  VariantSlot* slot = _head;
+  if (_index && _index->last) slot = _index->last->next();
+  for (; slot; slot = slot->next()) {
+    if (!_index) {
+      size_t capa = 8;
+      while (capa < 2 * ARDUINOJSON_ARRAY_INDEX_THRESHOLD) capa *= 2;
+      _index = CollectionIndex::create(capa, true, pool);
+      if (!_index) return;
+    } else if (_index->isFull()) {
+      // make room for all the remaining elements at once
+      size_t capa = 2 * _index->capacity;
+      while (capa < _index->count + slotSize(slot)) capa *= 2;
+      CollectionIndex* bigger = _index->resize(capa, pool);
+      if (!bigger) return;
+      _index = bigger;
+    }
+    _index->append(slot);
+  }
 }
+#endif
 
 inline size_t CollectionData::memoryUsage() const {
   size_t total = 0;
@@ -157,7 +359,11 @@ inline size_t CollectionData::nesting() const {
 }
 
 inline size_t CollectionData::size() const {
+#if ARDUINOJSON_CACHE_COLLECTION_SIZE
+  return _size;
+#else
   return slotSize(_head);
+#endif
 }
 
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,207 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include "../Memory/MemoryPool.hpp"
+#include "../Strings/StringHash.hpp"
+#include "../Variant/VariantSlot.hpp"
+
+#include <string.h>  // memcpy, memmove, strlen
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// The index of a large collection:
+// - for an object, an open-addressing hash table of the members,
+// - for an array, the table of the elements, in order.
+// The buckets follow the header. The table lives in the slot zone of the
+// MemoryPool, so its size is a multiple of sizeof(VariantSlot).
+//
+// The index covers the slots from the head to `last`; the slots added
+// after `last` are indexed by the next lookup that has access to the pool.
+struct CollectionIndex {
+  VariantSlot* last;
+  size_t count;
+  size_t capacity;  // number of buckets, a power of two for an object
+  bool isArray;
+
+  static CollectionIndex* create(size_t capa, bool forArray,
+                                 MemoryPool* pool) {
+    CollectionIndex* index =
+        static_cast<CollectionIndex*>(pool->allocRight(sizeOf(capa)));
+    if (!index) return 0;
+    index->capacity = capa;
+    index->isArray = forArray;
+    index->reset();
+    return index;
+  }
+
+  // Gives the memory back to the pool, as slots.
+  // The index must not be used after that.
+  void release(MemoryPool* pool) {
+    pool->freeSlotZone(this, sizeOf(capacity));
+  }
+
+  bool isFull() const {
+    if (isArray) return count == capacity;
+    // keep at least one empty bucket, so that find() stops
+    return 4 * (count + 1) > 3 * capacity;
+  }
+
+  // Removes a slot, if it's in the index.
+  // The position of an element is unknown, so the array index is emptied
+  // instead of shifted, and the next lookup rebuilds it; a slot right after
+  // `last` isn't indexed, so it leaves the index intact.
+  void erase(VariantSlot* slot, VariantSlot* previous) {
+    if (isArray) {
+      if (previous != last) truncate(0);
+      return;
+    }
+    eraseMember(slot);
+    if (last == slot) last = previous;
+  }
+
+  // Keeps only the first n elements
+  void truncate(size_t n) {
+    ARDUINOJSON_ASSERT(isArray && n <= count);
+    count = n;
+    last = n ? buckets()[n - 1] : 0;
+  }
+
+  // Returns the element at the specified index (must be lower than count)
+  VariantSlot* at(size_t index) const {
+    ARDUINOJSON_ASSERT(isArray && index < count);
+    return buckets()[index];
+  }
+
+  void append(VariantSlot* slot) {
+    ARDUINOJSON_ASSERT(isArray && count < capacity);
+    buckets()[count++] = slot;
+    last = slot;
+  }
+
+  // Returns a copy with the specified capacity, or 0 if the pool is full.
+  // The first `count` buckets are kept; the others are left uninitialized.
+  // When the index is the last block of the slot zone, the copy extends it
+  // in place. Otherwise, the index is released, which only recycles it with
+  // ARDUINOJSON_ENABLE_FREE_LISTS.
+  CollectionIndex* resize(size_t capa, MemoryPool* pool) {
+    ARDUINOJSON_ASSERT(capa >= count);
+    size_t oldSize = sizeOf(capacity);
+    size_t newSize = sizeOf(capa);
+    size_t usedSize = sizeof(CollectionIndex) + count * sizeof(VariantSlot*);
+    CollectionIndex* copy;
+    if (pool->isLastAllocRight(this) && newSize >= oldSize &&
+        pool->canAlloc(newSize - oldSize)) {
+      void* p = pool->allocRight(newSize - oldSize);
+      ARDUINOJSON_ASSERT(static_cast<char*>(p) + newSize - oldSize ==
+                         reinterpret_cast<char*>(this));
+      copy = static_cast<CollectionIndex*>(p);
+      memmove(copy, this, usedSize);
+    } else {
+      copy = static_cast<CollectionIndex*>(pool->allocRight(newSize));
+      if (!copy) return 0;
+      memcpy(copy, this, usedSize);
+      release(pool);
+    }
+    copy->capacity = capa;
+    return copy;
+  }
+
+  // Updates the slots, after MemoryPool::squashTo().
+  // The buckets of an array after count are uninitialized.
+  void movePointers(const MemoryPoolMove& move) {
+    VariantSlot** buckets = this->buckets();
+    size_t n = isArray ? count : capacity;
+    for (size_t i = 0; i < n; i++) buckets[i] = move.relocate(buckets[i]);
+    last = move.relocate(last);
+  }
+
+  // Removes all the slots from the index
+  void reset() {
+    VariantSlot** buckets = this->buckets();
+    for (size_t i = 0; i < capacity; i++) buckets[i] = 0;
+    count = 0;
+    last = 0;
+  }
+
+  template <typename TAdaptedString>
+  VariantSlot* find(TAdaptedString key) const {
+    ARDUINOJSON_ASSERT(!isArray && key.data() != 0);
+    VariantSlot* const* buckets = this->buckets();
+    size_t hash = hashString(key.data(), key.size());
+#if ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+    uint8_t fingerprint = fingerprintOf(hash);
+#endif
+    for (size_t i = bucketOf(hash); buckets[i]; i = nextBucket(i)) {
+#if ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+      if (buckets[i]->fingerprint() != fingerprint) continue;
+#endif
+      if (key.equals(buckets[i]->key())) return buckets[i];
+    }
+    return 0;
+  }
+
+  void insert(VariantSlot* slot) {
+    ARDUINOJSON_ASSERT(!isArray);
+    const char* key = slot->key();
+    if (!key) return;
+    VariantSlot** buckets = this->buckets();
+    size_t i = bucketOf(hashString(key, strlen(key)));
+    while (buckets[i]) i = nextBucket(i);
+    buckets[i] = slot;
+    count++;
+  }
+
+  static size_t sizeOf(size_t capa) {
+    size_t n = sizeof(CollectionIndex) + capa * sizeof(VariantSlot*);
+    return (n + sizeof(VariantSlot) - 1) / sizeof(VariantSlot) *
+           sizeof(VariantSlot);
+  }
+
+ private:
+  void eraseMember(VariantSlot* slot) {
+    const char* key = slot->key();
+    if (!key) return;
+    VariantSlot** buckets = this->buckets();
+    size_t i = bucketOf(hashString(key, strlen(key)));
+    while (buckets[i] != slot) {
+      if (!buckets[i]) return;  // not indexed
+      i = nextBucket(i);
+    }
+    // shift back the following entries, so that no probe sequence is broken
+    size_t j = i;
+    for (;;) {
+      j = nextBucket(j);
+      if (!buckets[j]) break;
+      const char* k = buckets[j]->key();
+      size_t home = bucketOf(hashString(k, strlen(k)));
+      bool canMove = i <= j ? (home <= i || home > j) : (home <= i && home > j);
+      if (canMove) {
+        buckets[i] = buckets[j];
+        i = j;
+      }
+    }
+    buckets[i] = 0;
+    count--;
+  }
+
+  VariantSlot** buckets() {
+    return reinterpret_cast<VariantSlot**>(this + 1);
+  }
+
+  VariantSlot* const* buckets() const {
+    return reinterpret_cast<VariantSlot* const*>(this + 1);
+  }
+
+  size_t bucketOf(size_t hash) const {
+    return hash & (capacity - 1);
+  }
+
+  size_t nextBucket(size_t i) const {
+    return (i + 1) & (capacity - 1);
+  }
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
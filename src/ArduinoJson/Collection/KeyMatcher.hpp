@@ -0,0 +1,43 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include "../Strings/StringHash.hpp"
+#include "../Variant/VariantSlot.hpp"
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Compares the key of the slots with the specified key.
+// When ARDUINOJSON_ENABLE_KEY_FINGERPRINT is set, the fingerprints are
+// compared first, so most of the mismatches don't touch the key string.
+template <typename TAdaptedString>
+class KeyMatcher {
+ public:
+  explicit KeyMatcher(TAdaptedString key) : _key(key) {
+#if ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+    // the content of a Flash string is not available (data() returns 0)
+    _hasFingerprint = key.data() != 0;
+    _fingerprint = _hasFingerprint
+                       ? fingerprintOf(hashString(key.data(), key.size()))
+                       : 0;
+#endif
+  }
+
+  bool matches(const VariantSlot* slot) const {
+#if ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+    if (_hasFingerprint && slot->fingerprint() != _fingerprint) return false;
+#endif
+    return _key.equals(slot->key());
+  }
+
+ private:
+  TAdaptedString _key;
+#if ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+  bool _hasFingerprint;
+  uint8_t _fingerprint;
+#endif
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
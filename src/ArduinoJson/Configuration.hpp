@@ -53,6 +53,16 @@
 #define ARDUINOJSON_DEFAULT_NESTING_LIMIT 10
 #endif
 
+// Embedded systems usually don't have std::atomic
+#ifndef ARDUINOJSON_ENABLE_DOCUMENT_POOL
+#define ARDUINOJSON_ENABLE_DOCUMENT_POOL 0
+#endif
+
+// Microcontrollers have no vector instructions, and words are small
+#ifndef ARDUINOJSON_ENABLE_SIMD
+#define ARDUINOJSON_ENABLE_SIMD 0
+#endif
+
 #else  // ARDUINOJSON_EMBEDDED_MODE
 
 // On a computer we have plenty of memory so we can use doubles
@@ -84,6 +94,17 @@
 #define ARDUINOJSON_DEFAULT_NESTING_LIMIT 50
 #endif
 
+// JsonDocumentPool uses std::atomic, so it needs C++11
+#ifndef ARDUINOJSON_ENABLE_DOCUMENT_POOL
+#define ARDUINOJSON_ENABLE_DOCUMENT_POOL 0
+#endif
+
+// Scan strings and spaces by blocks of 16 or 32 bytes (SSE2, AVX2, NEON), or
+// by words when the compiler doesn't target these instructions
+#ifndef ARDUINOJSON_ENABLE_SIMD
+#define ARDUINOJSON_ENABLE_SIMD 0
+#endif
+
 #endif  // ARDUINOJSON_EMBEDDED_MODE
 
 #ifdef ARDUINO
@@ -166,6 +187,124 @@
 #endif
 #endif
 
+// Allow BasicJsonDocument to chain extra blocks when the pool is full.
+// The deserializers continue in the new block instead of returning NoMemory,
+// so a stream can be parsed without knowing its size. garbageCollect() merges
+// the blocks afterwards.
+// CAUTION: this widens the offset between slots to pointer size
+#ifndef ARDUINOJSON_ENABLE_GROWABLE_POOL
+#define ARDUINOJSON_ENABLE_GROWABLE_POOL 0
+#endif
+
+// Recycle the slots and strings released by remove() and set()
+// CAUTION: a JsonVariant pointing to a removed value may see a new value, and
+// each string takes at least sizeof(char*) + sizeof(size_t) bytes
+#ifndef ARDUINOJSON_ENABLE_FREE_LISTS
+#define ARDUINOJSON_ENABLE_FREE_LISTS 0
+#endif
+
+// Store identical strings only once in the pool
+// 0 = no interning, 1 = intern keys, 2 = intern keys and string values
+// A duplicate is interned right after it's saved, while it's still the last
+// string of the pool, so the pool takes it back. Only a string recycled from
+// ARDUINOJSON_ENABLE_FREE_LISTS sits elsewhere, and goes back to the lists.
+#ifndef ARDUINOJSON_STRING_INTERNING
+#define ARDUINOJSON_STRING_INTERNING 0
+#endif
+
+// Store the number of elements in each array and object, so that size()
+// doesn't have to walk the list
+// CAUTION: this adds a size_t to every slot
+#ifndef ARDUINOJSON_CACHE_COLLECTION_SIZE
+#define ARDUINOJSON_CACHE_COLLECTION_SIZE 0
+#endif
+
+// Attach a hash index to large objects, so that finding a member by its key
+// doesn't have to compare all the keys
+// CAUTION: this adds a pointer to every slot
+// The index grows in place while it's the last allocation of the pool. After
+// that, without ARDUINOJSON_ENABLE_FREE_LISTS, each growth leaves the old
+// table behind; as the size doubles, this waste stays below the last table.
+#ifndef ARDUINOJSON_ENABLE_OBJECT_INDEX
+#define ARDUINOJSON_ENABLE_OBJECT_INDEX 0
+#endif
+
+// Number of members from which an object gets an index
+#ifndef ARDUINOJSON_OBJECT_INDEX_THRESHOLD
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 16
+#endif
+
+// Attach a table of the elements to large arrays, so that getting an element
+// by its index doesn't have to follow all the previous links
+// CAUTION: this adds a pointer to every slot
+#ifndef ARDUINOJSON_ENABLE_ARRAY_INDEX
+#define ARDUINOJSON_ENABLE_ARRAY_INDEX 0
+#endif
+
+// Number of elements from which an array gets an index
+#ifndef ARDUINOJSON_ARRAY_INDEX_THRESHOLD
+#define ARDUINOJSON_ARRAY_INDEX_THRESHOLD 16
+#endif
+
+// Store a one-byte hash of the key in each slot, so that looking for a member
+// can skip most of the string comparisons.
+// It fits in the padding of the slot, except on 8-bit microcontrollers.
+// Off by default, because every key that is stored pays for the hash, even
+// in programs that never look for a member.
+#ifndef ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+#define ARDUINOJSON_ENABLE_KEY_FINGERPRINT 0
+#endif
+
+// Store short string values in the slot, instead of the string zone of the
+// MemoryPool; a slot holds up to 15 characters on 64-bit, 7 on 32-bit
+#ifndef ARDUINOJSON_ENABLE_INLINE_STRINGS
+#define ARDUINOJSON_ENABLE_INLINE_STRINGS 0
+#endif
+
+// Store the arrays of numbers produced by deserializeJson() as typed arrays,
+// where each element takes 1 to 8 bytes instead of a slot. Only the arrays of
+// integers and the arrays of floats are typed; a mix of both uses slots.
+// CAUTION: a typed array is converted to slots as soon as it's accessed
+// through a JsonArray, which fails if the pool can't hold the slots.
+// JsonArrayConst and JsonVariantConst read it in place, without conversion.
+#ifndef ARDUINOJSON_ENABLE_TYPED_ARRAYS
+#define ARDUINOJSON_ENABLE_TYPED_ARRAYS 0
+#endif
+
+// Link the string values to the input, instead of copying them in the pool,
+// when the input is a const char* that outlives the JsonDocument. Only the
+// values that need no decoding are linked; the keys and the other values are
+// copied, and so are the strings of a std::string or a String input.
+// CAUTION: a linked value has no terminator, so is<const char*>() is false
+// and as<const char*>() returns null; read it with as<std::string>(), the
+// comparison operators, the numeric conversions or the serializers.
+#ifndef ARDUINOJSON_ENABLE_LINKED_INPUT
+#define ARDUINOJSON_ENABLE_LINKED_INPUT 0
+#endif
+
+// Count the slots and the peak memory usage of each MemoryPool, so that
+// JsonDocument::memoryStats() can tell how the memory is used
+#ifndef ARDUINOJSON_ENABLE_POOL_STATS
+#define ARDUINOJSON_ENABLE_POOL_STATS 0
+#endif
+
+// The instructions that the scanners of ARDUINOJSON_ENABLE_SIMD use:
+// 0 = words, 1 = SSE2, 2 = AVX2, 3 = NEON.
+// It's part of the namespace, so that the translation units compiled for
+// different targets don't share the same scanners.
+#if !ARDUINOJSON_ENABLE_SIMD
+#define ARDUINOJSON_SIMD_ISA 0
+#elif defined(__AVX2__)
+#define ARDUINOJSON_SIMD_ISA 2
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ARDUINOJSON_SIMD_ISA 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ARDUINOJSON_SIMD_ISA 3
+#else
+#define ARDUINOJSON_SIMD_ISA 0
+#endif
+
 #ifndef ARDUINOJSON_TAB
 #define ARDUINOJSON_TAB "  "
 #endif
@@ -21,6 +21,10 @@ struct ArduinoStreamReader {
     uint8_t c;
     return _stream.readBytes(&c, 1) ? c : -1;
   }
+
+  size_t readBytes(char* buffer, size_t n) {
+    return _stream.readBytes(buffer, n);
+  }
 };
 
 inline ArduinoStreamReader makeReader(Stream& input) {
@@ -4,6 +4,12 @@
 
 #pragma once
 
+#include <string.h>  // memcpy
+
+#if ARDUINOJSON_ENABLE_STD_STRING
+#include <string>
+#endif
+
 namespace ARDUINOJSON_NAMESPACE {
 
 template <typename T>
@@ -26,6 +32,22 @@ class UnsafeCharPointerReader {
   int read() {
     return static_cast<unsigned char>(*_ptr++);
   }
+
+  size_t readBytes(char* buffer, size_t n) {
+    memcpy(buffer, _ptr, n);
+    _ptr += n;
+    return n;
+  }
+
+  // The size is unknown, the span ends with the NUL terminator
+  const char* peekSpan(size_t& size) {
+    size = size_t(-1);
+    return _ptr;
+  }
+
+  void skip(size_t n) {
+    _ptr += n;
+  }
 };
 
 class SafeCharPointerReader {
@@ -42,6 +64,23 @@ class SafeCharPointerReader {
     else
       return -1;
   }
+
+  size_t readBytes(char* buffer, size_t n) {
+    size_t available = size_t(_end - _ptr);
+    if (n > available) n = available;
+    memcpy(buffer, _ptr, n);
+    _ptr += n;
+    return n;
+  }
+
+  const char* peekSpan(size_t& size) {
+    size = size_t(_end - _ptr);
+    return _ptr;
+  }
+
+  void skip(size_t n) {
+    _ptr += n;
+  }
 };
 
 template <typename TChar>
@@ -58,6 +97,13 @@ inline
   return SafeCharPointerReader(reinterpret_cast<const char*>(input), n);
 }
 
+#if ARDUINOJSON_ENABLE_STD_STRING
+// std::string is contiguous, so it doesn't need an IteratorReader
+inline SafeCharPointerReader makeReader(const std::string& input) {
+  return SafeCharPointerReader(input.data(), input.size());
+}
+#endif
+
 #if ARDUINOJSON_ENABLE_ARDUINO_STRING
 inline SafeCharPointerReader makeReader(const ::String& input) {
   return SafeCharPointerReader(input.c_str(), input.length());
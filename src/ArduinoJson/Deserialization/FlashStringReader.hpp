@@ -17,6 +17,12 @@ class UnsafeFlashStringReader {
   int read() {
     return pgm_read_byte_near(_ptr++);
   }
+
+  size_t readBytes(char* buffer, size_t n) {
+    memcpy_P(buffer, _ptr, n);
+    _ptr += n;
+    return n;
+  }
 };
 
 class SafeFlashStringReader {
@@ -33,6 +39,14 @@ class SafeFlashStringReader {
     else
       return -1;
   }
+
+  size_t readBytes(char* buffer, size_t n) {
+    size_t available = size_t(_end - _ptr);
+    if (n > available) n = available;
+    memcpy_P(buffer, _ptr, n);
+    _ptr += n;
+    return n;
+  }
 };
 
 inline UnsafeFlashStringReader makeReader(const __FlashStringHelper* input) {
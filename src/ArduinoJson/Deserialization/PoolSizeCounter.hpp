@@ -0,0 +1,233 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include "../Array/TypedArrayBuilder.hpp"
+#include "../Memory/MemoryPool.hpp"
+#include "../Numbers/parseNumber.hpp"
+#include "../Polyfills/gsl/not_null.hpp"
+#include "../Polyfills/type_traits.hpp"
+#include "../StringStorage/StringStorage.hpp"
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Adds up the bytes that a deserializer takes from the MemoryPool, without
+// building anything (see measureDeserializeJson()).
+// The deserializer runs its usual code, with a PoolSizeCounter as its string
+// storage and a VariantSizeCounter in place of the VariantData.
+// The strings count only when the input's own storage copies them in the pool.
+//
+// The result is exact, except with ARDUINOJSON_STRING_INTERNING,
+// ARDUINOJSON_ENABLE_INLINE_STRINGS and ARDUINOJSON_ENABLE_TYPED_ARRAYS,
+// where it's the peak usage in the worst case, and with
+// ARDUINOJSON_ENABLE_LINKED_INPUT, where the linked values count as copies.
+class PoolSizeCounter {
+ public:
+  // A StringBuilder that only counts the characters
+  class StringBuilder {
+   public:
+    explicit StringBuilder(PoolSizeCounter* counter)
+        : _counter(counter), _size(0) {}
+
+    void append(char) {
+      _size++;
+    }
+
+    void append(const char*, size_t n) {
+      _size += n;
+    }
+
+    size_t size() const {
+      return _size;
+    }
+
+    // Returns an empty string, because the characters are not kept
+    const char* complete() const {
+      _counter->addString(_size);
+      return "";
+    }
+
+   private:
+    PoolSizeCounter* _counter;
+    size_t _size;
+  };
+
+  explicit PoolSizeCounter(bool copiesStrings)
+      : _size(0), _internedStrings(0), _copiesStrings(copiesStrings) {}
+
+  StringBuilder startString() {
+    return StringBuilder(this);
+  }
+
+  size_t size() const {
+#if ARDUINOJSON_STRING_INTERNING
+    return _size + MemoryPool::internTableSize(_internedStrings);
+#else
+    return _size;
+#endif
+  }
+
+  void addSlots(size_t n) {
+    _size += n * sizeof(VariantSlot);
+  }
+
+  // A string of n characters
+  void addString(size_t n) {
+    if (_copiesStrings) _size += MemoryPool::stringSize(n + 1);
+  }
+
+  // The last string is a key
+  void addKey() {
+#if ARDUINOJSON_STRING_INTERNING >= 1
+    if (_copiesStrings) _internedStrings++;
+#endif
+  }
+
+  // The last string is a value
+  void addValue() {
+#if ARDUINOJSON_STRING_INTERNING >= 2
+    if (_copiesStrings) _internedStrings++;
+#endif
+  }
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  // A typed array that falls back to slots after n numbers.
+  // The packed numbers are released only after the slots are allocated.
+  void addTypedArrayFallback(size_t n) {
+    _size += n * TypedArrayBuilder::cellSize;
+  }
+#endif
+
+ private:
+  size_t _size;
+  size_t _internedStrings;
+  bool _copiesStrings;
+};
+
+// Stands for the VariantData, the CollectionData and the VariantSlot that a
+// deserializer fills, and tells the PoolSizeCounter what they would take.
+// Nothing is stored, so the elements and the members share the same instance.
+class VariantSizeCounter {
+ public:
+  explicit VariantSizeCounter(PoolSizeCounter* counter) : _counter(counter) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    _typedArraySize = 0;
+#endif
+  }
+
+  VariantSizeCounter& toArray() {
+    return *this;
+  }
+
+  VariantSizeCounter& toObject() {
+    return *this;
+  }
+
+  VariantSizeCounter* asArray() {
+    return this;
+  }
+
+  VariantSizeCounter* add(MemoryPool*) {
+    _counter->addSlots(1);
+    return this;
+  }
+
+  VariantSizeCounter* addSlot(MemoryPool*) {
+    _counter->addSlots(1);
+    return this;
+  }
+
+  VariantSizeCounter* data() {
+    return this;
+  }
+
+  void setOwnedKey(not_null<const char*>) {
+    _counter->addKey();
+  }
+
+  void setSavedString(const char*, size_t, MemoryPool*) {
+    _counter->addValue();
+  }
+
+  void setBoolean(bool) {}
+
+  template <typename T>
+  void setFloat(T) {}
+
+  template <typename T>
+  void setInteger(T) {}
+
+  template <typename T>
+  void setSignedInteger(T) {}
+
+  template <typename T>
+  void setUnsignedInteger(T) {}
+
+  template <typename T>
+  void setNegativeInteger(T) {}
+
+  template <typename T>
+  void setPositiveInteger(T) {}
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  // Counts a slot per number, like a regular array, because that's more than
+  // a typed array takes, except when it falls back to slots
+  void setTypedArray(size_t size) {
+    _counter->addSlots(size);
+    _typedArraySize = size;
+  }
+
+  bool expandTypedArray(MemoryPool*) {
+    _counter->addTypedArrayFallback(_typedArraySize);
+    return true;
+  }
+#endif
+
+ private:
+  PoolSizeCounter* _counter;
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  size_t _typedArraySize;
+#endif
+};
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+// Stands for the TypedArrayBuilder of a VariantSizeCounter
+class TypedArraySizeCounter {
+ public:
+  TypedArraySizeCounter() : _size(0), _isFloat(false) {}
+
+  bool canStore(const ParsedNumber<Float, UInt>& number) const {
+    return TypedArrayBuilder::canStore(number, _size, _isFloat);
+  }
+
+  bool append(const ParsedNumber<Float, UInt>& number) {
+    if (number.type() == VALUE_IS_FLOAT) _isFloat = true;
+    _size++;
+    return true;
+  }
+
+  size_t complete() const {
+    return _size;
+  }
+
+ private:
+  size_t _size;
+  bool _isFloat;
+};
+#endif
+
+template <typename TInput>
+PoolSizeCounter makePoolSizeCounter(TInput&) {
+  return PoolSizeCounter(
+      !is_same<typename StringStorage<TInput>::type, StringMover>::value);
+}
+
+template <typename TChar>
+PoolSizeCounter makePoolSizeCounter(TChar*) {
+  return PoolSizeCounter(
+      !is_same<typename StringStorage<TChar*>::type, StringMover>::value);
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,76 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include "../Polyfills/type_traits.hpp"
+
+#include <stddef.h>  // size_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// A reader must have:
+//   int read();  // the next byte, or -1 at the end of the input
+//
+// It may also have:
+//   // Reads up to n bytes; returns the number of bytes read
+//   size_t readBytes(char* buffer, size_t n);
+//
+//   // Returns the bytes that can be read in place, without consuming them.
+//   // When the reader doesn't know where the input ends, size is
+//   // size_t(-1), and the caller must stop at the NUL terminator.
+//   const char* peekSpan(size_t& size);
+//   void skip(size_t n);  // consumes n bytes of the span
+template <typename TReader>
+class ReaderTraits {
+ protected:  // <- to avoid GCC's "all member functions in class are private"
+  typedef char Yes[1];
+  typedef char No[2];
+
+  template <typename T, size_t (T::*)(char*, size_t)>
+  struct ReadBytesSignature {};
+
+  template <typename T, const char* (T::*)(size_t&)>
+  struct PeekSpanSignature {};
+
+  template <typename T>
+  static Yes& probeReadBytes(ReadBytesSignature<T, &T::readBytes>*);
+  template <typename T>
+  static No& probeReadBytes(...);
+
+  template <typename T>
+  static Yes& probePeekSpan(PeekSpanSignature<T, &T::peekSpan>*);
+  template <typename T>
+  static No& probePeekSpan(...);
+
+ public:
+  static const bool hasReadBytes =
+      sizeof(probeReadBytes<TReader>(0)) == sizeof(Yes);
+  static const bool hasPeekSpan =
+      sizeof(probePeekSpan<TReader>(0)) == sizeof(Yes);
+
+  // Reads up to n bytes, in one call if the reader supports it
+  static size_t readBytes(TReader& reader, char* buffer, size_t n) {
+    return readBytes(reader, buffer, n,
+                     integral_constant<bool, hasReadBytes>());
+  }
+
+ private:
+  static size_t readBytes(TReader& reader, char* buffer, size_t n,
+                          true_type) {
+    return reader.readBytes(buffer, n);
+  }
+
+  static size_t readBytes(TReader& reader, char* buffer, size_t n,
+                          false_type) {
+    for (size_t i = 0; i < n; i++) {
+      int c = reader.read();
+      if (c < 0) return i;
+      buffer[i] = static_cast<char>(c);
+    }
+    return n;
+  }
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
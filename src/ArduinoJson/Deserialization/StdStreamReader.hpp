@@ -10,20 +10,46 @@
 
 namespace ARDUINOJSON_NAMESPACE {
 
+// Reads from the stream's buffer, which already holds a block of the input.
+// Unlike istream::get(), sbumpc() doesn't construct a sentry for each
+// character, and only makes a virtual call when the buffer is empty.
+// Unlike istream::read(), it doesn't take the characters that follow the
+// document.
 class StdStreamReader {
-  std::istream& _stream;
-  char _current;
+  // pointers, so that the reader is assignable (Visual Studio C4512), and
+  // copyable without a deprecated implicit copy constructor
+  std::istream* _stream;
+  std::streambuf* _buffer;
 
  public:
   explicit StdStreamReader(std::istream& stream)
-      : _stream(stream), _current(0) {}
+      : _stream(&stream), _buffer(0) {
+    std::istream::sentry ok(stream, true);  // true = don't skip spaces
+    if (ok) _buffer = stream.rdbuf();
+  }
 
   int read() {
-    return _stream.get();
+    if (!_buffer) return -1;
+    int c = _buffer->sbumpc();  // the char as unsigned, or EOF
+    if (c == std::char_traits<char>::eof()) {
+      // like istream::get()
+      _stream->setstate(std::ios::failbit | std::ios::eofbit);
+      _buffer = 0;
+    }
+    return c;
   }
 
- private:
-  StdStreamReader& operator=(const StdStreamReader&);  // Visual Studio C4512
+  size_t readBytes(char* buffer, size_t n) {
+    if (!_buffer) return 0;
+    size_t count = static_cast<size_t>(
+        _buffer->sgetn(buffer, static_cast<std::streamsize>(n)));
+    if (count < n) {
+      // like istream::read()
+      _stream->setstate(std::ios::failbit | std::ios::eofbit);
+      _buffer = 0;
+    }
+    return count;
+  }
 };
 
 inline StdStreamReader makeReader(std::istream& input) {
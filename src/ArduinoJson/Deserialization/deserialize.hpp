@@ -11,6 +11,8 @@
 #include "FlashStringReader.hpp"
 #include "IteratorReader.hpp"
 #include "NestingLimit.hpp"
+#include "PoolSizeCounter.hpp"
+#include "ReaderTraits.hpp"
 #include "StdStreamReader.hpp"
 
 namespace ARDUINOJSON_NAMESPACE {
@@ -73,4 +75,56 @@ DeserializationError deserialize(JsonDocument &doc, TStream &input,
              makeStringStorage(doc.memoryPool(), input), nestingLimit.value)
       .parse(doc.data());
 }
+
+// The measuring functions below run the deserializer with a PoolSizeCounter
+// instead of the string storage; it only reads the input and counts what it
+// would allocate, so the pool stays empty.
+//
+// measureDeserialize(const std::string&);
+// measureDeserialize(const String&);
+template <template <typename, typename> class TDeserializer, typename TString>
+typename enable_if<!is_array<TString>::value, size_t>::type measureDeserialize(
+    const TString &input, NestingLimit nestingLimit) {
+  MemoryPool pool(0, 0);
+  return makeDeserializer<TDeserializer>(pool, makeReader(input),
+                                         makePoolSizeCounter(input),
+                                         nestingLimit.value)
+      .measure();
+}
+//
+// measureDeserialize(char*);
+// measureDeserialize(const char*);
+// measureDeserialize(const __FlashStringHelper*);
+template <template <typename, typename> class TDeserializer, typename TChar>
+size_t measureDeserialize(TChar *input, NestingLimit nestingLimit) {
+  MemoryPool pool(0, 0);
+  return makeDeserializer<TDeserializer>(pool, makeReader(input),
+                                         makePoolSizeCounter(input),
+                                         nestingLimit.value)
+      .measure();
+}
+//
+// measureDeserialize(char*, size_t);
+// measureDeserialize(const char*, size_t);
+// measureDeserialize(const __FlashStringHelper*, size_t);
+template <template <typename, typename> class TDeserializer, typename TChar>
+size_t measureDeserialize(TChar *input, size_t inputSize,
+                          NestingLimit nestingLimit) {
+  MemoryPool pool(0, 0);
+  return makeDeserializer<TDeserializer>(pool, makeReader(input, inputSize),
+                                         makePoolSizeCounter(input),
+                                         nestingLimit.value)
+      .measure();
+}
+//
+// measureDeserialize(std::istream&);
+// measureDeserialize(Stream&);
+template <template <typename, typename> class TDeserializer, typename TStream>
+size_t measureDeserialize(TStream &input, NestingLimit nestingLimit) {
+  MemoryPool pool(0, 0);
+  return makeDeserializer<TDeserializer>(pool, makeReader(input),
+                                         makePoolSizeCounter(input),
+                                         nestingLimit.value)
+      .measure();
+}
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -8,6 +8,26 @@
 
 namespace ARDUINOJSON_NAMESPACE {
 
+// A meta-function that returns true if TAllocator has a member function
+// void* reallocate(void* p, size_t n)
+template <typename TAllocator>
+class HasReallocate {
+ protected:  // <- to avoid GCC's "all member functions in class are private"
+  typedef char Yes[1];
+  typedef char No[2];
+
+  template <typename T, void* (T::*)(void*, size_t)>
+  struct Signature {};
+
+  template <typename T>
+  static Yes& probe(Signature<T, &T::reallocate>*);
+  template <typename T>
+  static No& probe(...);
+
+ public:
+  static const bool value = sizeof(probe<TAllocator>(0)) == sizeof(Yes);
+};
+
 template <typename TAllocator>
 class AllocatorOwner {
  protected:
@@ -15,6 +35,11 @@ class AllocatorOwner {
   AllocatorOwner(const AllocatorOwner& src) : _allocator(src._allocator) {}
   AllocatorOwner(TAllocator allocator) : _allocator(allocator) {}
 
+  AllocatorOwner& operator=(const AllocatorOwner& src) {
+    _allocator = src._allocator;
+    return *this;
+  }
+
   void* allocate(size_t n) {
     return _allocator.allocate(n);
   }
@@ -23,7 +48,23 @@ class AllocatorOwner {
     _allocator.deallocate(p);
   }
 
+  // Resizes the block pointed by p, like realloc().
+  // Returns 0 if the allocator doesn't support it, or if it fails; in both
+  // cases, p remains valid.
+  void* reallocate(void* p, size_t n) {
+    return reallocate(
+        p, n, integral_constant<bool, HasReallocate<TAllocator>::value>());
+  }
+
  private:
+  void* reallocate(void* p, size_t n, true_type) {
+    return _allocator.reallocate(p, n);
+  }
+
+  void* reallocate(void*, size_t, false_type) {
+    return 0;
+  }
+
   TAllocator _allocator;
 };
 
@@ -39,6 +80,14 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
     set(src);
   }
 
+#if __cplusplus >= 201103L
+  // Takes the pool of src, which is left empty with a capacity of zero
+  BasicJsonDocument(BasicJsonDocument&& src)
+      : AllocatorOwner<TAllocator>(src), JsonDocument(MemoryPool(0, 0)) {
+    movePool(src);
+  }
+#endif
+
   template <typename T>
   BasicJsonDocument(const T& src,
                     typename enable_if<IsVisitable<T>::value>::type* = 0)
@@ -53,7 +102,7 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
   }
 
   ~BasicJsonDocument() {
-    freePool();
+    freePool(memoryPool());
   }
 
   BasicJsonDocument& operator=(const BasicJsonDocument& src) {
@@ -62,6 +111,18 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
     return *this;
   }
 
+#if __cplusplus >= 201103L
+  // Releases the pool, then takes the pool and the allocator of src.
+  // src is left empty with a capacity of zero.
+  BasicJsonDocument& operator=(BasicJsonDocument&& src) {
+    if (this == &src) return *this;
+    freePool(memoryPool());
+    AllocatorOwner<TAllocator>::operator=(src);
+    movePool(src);
+    return *this;
+  }
+#endif
+
   template <typename T>
   BasicJsonDocument& operator=(const T& src) {
     reallocPoolIfTooSmall(src.memoryUsage());
@@ -69,20 +130,141 @@ class BasicJsonDocument : AllocatorOwner<TAllocator>, public JsonDocument {
     return *this;
   }
 
+  // Reclaims the memory leaked by remove() and by overwritten values.
+  // Returns false if the temporary pool can't be allocated.
+  // CAUTION: invalidates all the JsonVariant, JsonArray and JsonObject
+  bool garbageCollect() {
+    return moveToNewPool(capacity());
+  }
+
+  // Reduces the capacity to the memory used by the strings and the slots.
+  // The slots are moved next to the strings, then the buffer is truncated
+  // with reallocate(), or copied if the allocator doesn't support it.
+  // It doesn't reclaim the memory leaked by remove(): call garbageCollect()
+  // first. With ARDUINOJSON_ENABLE_GROWABLE_POOL, garbageCollect() also
+  // merges the extra blocks.
+  // Returns false if the buffer can't be reallocated or copied.
+  // CAUTION: invalidates all the JsonVariant, JsonArray and JsonObject
+  bool shrinkToFit() {
+    MemoryPool& pool = memoryPool();
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    if (pool.hasBlocks() && (!garbageCollect() || pool.hasBlocks()))
+      return false;
+#endif
+    size_t capa = pool.squashedCapacity();
+    if (capa == pool.capacity()) return true;
+    if (!capa) {
+      freePool(pool);
+      replacePool(allocPool(0));
+      return true;
+    }
+
+    char* buffer = static_cast<char*>(pool.buffer());
+    MemoryPoolMove move;
+    bool ok = true;
+    if (HasReallocate<TAllocator>::value) {
+      move = pool.squashTo(buffer);
+      char* newBuffer = static_cast<char*>(this->reallocate(buffer, capa));
+      // on failure, the squashed pool stays in the old buffer
+      if (newBuffer)
+        move.shift(reinterpret_cast<size_t>(newBuffer) -
+                   reinterpret_cast<size_t>(buffer));
+      else
+        ok = false;
+    } else {
+      char* newBuffer = static_cast<char*>(this->allocate(capa));
+      if (!newBuffer) return false;
+      move = pool.squashTo(newBuffer);
+      this->deallocate(buffer);
+    }
+    pool.relocate(move);
+    data().movePointers(move);
+    return ok;
+  }
+
  private:
+  // Copies the live tree to a new pool, then releases the old one
+  bool moveToNewPool(size_t capa) {
+    MemoryPool pool = allocPool(capa);
+    if (!pool.buffer() && capa) return false;
+    VariantData tmp;
+    tmp.setNull();
+    if (!tmp.copyFrom(data(), &pool)) {
+      freePool(pool);
+      return false;
+    }
+    freePool(memoryPool());
+    replacePool(pool);
+    data() = tmp;
+    return true;
+  }
+
   MemoryPool allocPool(size_t requiredSize) {
     size_t capa = addPadding(requiredSize);
-    return MemoryPool(reinterpret_cast<char*>(this->allocate(capa)), capa);
+    MemoryPool pool(reinterpret_cast<char*>(this->allocate(capa)), capa);
+    attachPool(pool);
+    return pool;
   }
 
+  // Makes the pool allocate its extra blocks through this document
+  void attachPool(MemoryPool& pool) {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    MemoryBlockAllocator blockAllocator = {allocateBlock, deallocateBlock, this};
+    pool.setBlockAllocator(blockAllocator);
+#else
+    (void)pool;
+#endif
+  }
+
+  // Takes the pool and the values of src, and leaves src empty.
+  // The current pool must have been released.
+  void movePool(BasicJsonDocument& src) {
+    MemoryPool pool = src.memoryPool();
+    attachPool(pool);
+    replacePool(pool);
+    data() = src.data();
+
+    MemoryPool empty(0, 0);
+    src.attachPool(empty);
+    src.replacePool(empty);
+    src.data().setNull();
+  }
+
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  static void* allocateBlock(void* doc, size_t n) {
+    return static_cast<BasicJsonDocument*>(doc)->allocate(n);
+  }
+
+  static void deallocateBlock(void* doc, void* p) {
+    static_cast<BasicJsonDocument*>(doc)->deallocate(p);
+  }
+#endif
+
+  // Grows the pool, whose content is about to be overwritten.
+  // With an allocator that supports reallocate(), the block may grow in place.
   void reallocPoolIfTooSmall(size_t requiredSize) {
     if (requiredSize <= capacity()) return;
-    freePool();
-    replacePool(allocPool(addPadding(requiredSize)));
+    size_t capa = addPadding(requiredSize);
+    MemoryPool& pool = memoryPool();
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    pool.clear();  // release the extra blocks
+#endif
+    void* buffer = pool.buffer() ? this->reallocate(pool.buffer(), capa) : 0;
+    if (buffer) {
+      MemoryPool newPool(reinterpret_cast<char*>(buffer), capa);
+      attachPool(newPool);
+      replacePool(newPool);
+    } else {
+      freePool(pool);
+      replacePool(allocPool(capa));
+    }
   }
 
-  void freePool() {
-    this->deallocate(memoryPool().buffer());
+  void freePool(MemoryPool& pool) {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    pool.clear();  // release the extra blocks
+#endif
+    this->deallocate(pool.buffer());
   }
 };
 
@@ -6,7 +6,7 @@
 
 #include "BasicJsonDocument.hpp"
 
-#include <stdlib.h>  // malloc, free
+#include <stdlib.h>  // malloc, free, realloc
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -18,6 +18,10 @@ struct DefaultAllocator {
   void deallocate(void* p) {
     free(p);
   }
+
+  void* reallocate(void* p, size_t n) {
+    return realloc(p, n);
+  }
 };
 
 typedef BasicJsonDocument<DefaultAllocator> DynamicJsonDocument;
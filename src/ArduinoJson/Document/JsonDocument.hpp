@@ -49,6 +49,19 @@ class JsonDocument : public Visitable {
     return _pool.size();
   }
 
+#if ARDUINOJSON_ENABLE_POOL_STATS
+  // Walks the tree to find the dead bytes, so it takes linear time.
+  // The dead bytes are approximate with ARDUINOJSON_STRING_INTERNING and the
+  // collection indexes.
+  MemoryPoolStats memoryStats() {
+    MemoryPoolStats stats = _pool.stats();
+    size_t live = _data.memoryUsage();
+    size_t used = stats.stringBytes + stats.slotBytes - stats.freeBytes;
+    stats.deadBytes = used > live ? used - live : 0;
+    return stats;
+  }
+#endif
+
   size_t nesting() const {
     return _data.nesting();
   }
@@ -187,11 +200,11 @@ class JsonDocument : public Visitable {
   }
 
   FORCE_INLINE VariantRef getElement(size_t index) {
-    return VariantRef(&_pool, _data.getElement(index));
+    return VariantRef(&_pool, _data.getElement(index, &_pool));
   }
 
   FORCE_INLINE VariantConstRef getElement(size_t index) const {
-    return VariantConstRef(_data.getElement(index));
+    return VariantConstRef(&_data)[index];
   }
 
   // JsonVariantConst getMember(char*) const
@@ -216,7 +229,7 @@ class JsonDocument : public Visitable {
   // JsonVariant getMember(const __FlashStringHelper*)
   template <typename TChar>
   FORCE_INLINE VariantRef getMember(TChar* key) {
-    return VariantRef(&_pool, _data.getMember(adaptString(key)));
+    return VariantRef(&_pool, _data.getMember(adaptString(key), &_pool));
   }
 
   // JsonVariant getMember(const std::string&)
@@ -224,7 +237,7 @@ class JsonDocument : public Visitable {
   template <typename TString>
   FORCE_INLINE typename enable_if<IsString<TString>::value, VariantRef>::type
   getMember(const TString& key) {
-    return VariantRef(&_pool, _data.getMember(adaptString(key)));
+    return VariantRef(&_pool, _data.getMember(adaptString(key), &_pool));
   }
 
   // getOrAddMember(char*)
@@ -260,7 +273,7 @@ class JsonDocument : public Visitable {
   }
 
   FORCE_INLINE void remove(size_t index) {
-    _data.remove(index);
+    _data.remove(index, &_pool);
   }
   // remove(char*)
   // remove(const char*)
@@ -268,14 +281,14 @@ class JsonDocument : public Visitable {
   template <typename TChar>
   FORCE_INLINE typename enable_if<IsString<TChar*>::value>::type remove(
       TChar* key) {
-    _data.remove(adaptString(key));
+    _data.remove(adaptString(key), &_pool);
   }
   // remove(const std::string&)
   // remove(const String&)
   template <typename TString>
   FORCE_INLINE typename enable_if<IsString<TString>::value>::type remove(
       const TString& key) {
-    _data.remove(adaptString(key));
+    _data.remove(adaptString(key), &_pool);
   }
 
  protected:
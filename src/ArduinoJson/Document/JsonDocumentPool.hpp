@@ -0,0 +1,170 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include "../Configuration.hpp"
+
+#if ARDUINOJSON_ENABLE_DOCUMENT_POOL
+
+#include "../Polyfills/assert.hpp"
+#include "DynamicJsonDocument.hpp"
+
+#include <atomic>
+#include <initializer_list>
+
+namespace ARDUINOJSON_NAMESPACE {
+
+template <typename TAllocator>
+class BasicJsonDocumentPool;
+
+// A document borrowed from a BasicJsonDocumentPool.
+// The document goes back to the pool, cleared, when the handle is destroyed.
+template <typename TAllocator>
+class PooledJsonDocument {
+  typedef BasicJsonDocument<TAllocator> document_type;
+
+ public:
+  PooledJsonDocument(PooledJsonDocument&& src)
+      : _doc(src._doc), _busy(src._busy) {
+    src._doc = 0;
+    src._busy = 0;
+  }
+
+  PooledJsonDocument(const PooledJsonDocument&) = delete;
+  PooledJsonDocument& operator=(const PooledJsonDocument&) = delete;
+
+  ~PooledJsonDocument() {
+    release();
+  }
+
+  PooledJsonDocument& operator=(PooledJsonDocument&& src) {
+    if (this != &src) {
+      release();
+      _doc = src._doc;
+      _busy = src._busy;
+      src._doc = 0;
+      src._busy = 0;
+    }
+    return *this;
+  }
+
+  document_type& operator*() const {
+    return *_doc;
+  }
+
+  document_type* operator->() const {
+    return _doc;
+  }
+
+  // Tells if the document comes from the pool.
+  // When the pool has no free document big enough, the handle owns a
+  // document allocated for the occasion.
+  bool isPooled() const {
+    return _busy != 0;
+  }
+
+  // Gives the document back; the handle must not be used after that
+  void release() {
+    if (!_doc) return;
+    if (_busy) {
+      _doc->clear();
+      _busy->store(false, std::memory_order_release);
+    } else {
+      delete _doc;
+    }
+    _doc = 0;
+    _busy = 0;
+  }
+
+ private:
+  friend class BasicJsonDocumentPool<TAllocator>;
+
+  PooledJsonDocument(document_type* doc, std::atomic<bool>* busy)
+      : _doc(doc), _busy(busy) {}
+
+  document_type* _doc;
+  std::atomic<bool>* _busy;
+};
+
+// A set of documents allocated once, and lent to threads one at a time.
+// The documents are grouped by capacity class; acquire() returns a free
+// document of the smallest class that is big enough.
+// A document is taken with an atomic exchange of its flag, so acquire() and
+// release() never lock. Each call starts its search at a different entry,
+// so that concurrent threads don't fight for the first ones.
+//
+// CAUTION: don't change the capacity of a pooled document, for example with
+// shrinkToFit() or by moving it.
+template <typename TAllocator>
+class BasicJsonDocumentPool {
+  typedef BasicJsonDocument<TAllocator> document_type;
+
+  struct Entry {
+    std::atomic<bool> busy;
+    document_type* doc;
+    size_t capacity;  // of the class, read without touching the document
+  };
+
+ public:
+  // Allocates `count` documents for each capacity, which must be increasing
+  BasicJsonDocumentPool(std::initializer_list<size_t> capacities,
+                        size_t count, TAllocator allocator = TAllocator())
+      : _entries(new Entry[capacities.size() * count]),
+        _size(capacities.size() * count),
+        _count(count),
+        _next(0),
+        _allocator(allocator) {
+    size_t i = 0;
+    for (size_t capa : capacities) {
+      ARDUINOJSON_ASSERT(!i || capa >= _entries[i - 1].capacity);
+      for (size_t j = 0; j < count; j++, i++) {
+        _entries[i].busy.store(false, std::memory_order_relaxed);
+        _entries[i].doc = new document_type(capa, allocator);
+        _entries[i].capacity = capa;
+      }
+    }
+  }
+
+  BasicJsonDocumentPool(const BasicJsonDocumentPool&) = delete;
+  BasicJsonDocumentPool& operator=(const BasicJsonDocumentPool&) = delete;
+
+  // All the documents must have been released
+  ~BasicJsonDocumentPool() {
+    for (size_t i = 0; i < _size; i++) {
+      ARDUINOJSON_ASSERT(!_entries[i].busy.load());
+      delete _entries[i].doc;
+    }
+    delete[] _entries;
+  }
+
+  // Returns an empty document with at least the specified capacity
+  PooledJsonDocument<TAllocator> acquire(size_t capa) {
+    size_t offset = _next.fetch_add(1, std::memory_order_relaxed);
+    for (size_t first = 0; first < _size; first += _count) {
+      if (_entries[first].capacity < capa) continue;
+      for (size_t j = 0; j < _count; j++) {
+        Entry& entry = _entries[first + (offset + j) % _count];
+        if (entry.busy.load(std::memory_order_relaxed)) continue;
+        if (entry.busy.exchange(true, std::memory_order_acquire)) continue;
+        return PooledJsonDocument<TAllocator>(entry.doc, &entry.busy);
+      }
+    }
+    return PooledJsonDocument<TAllocator>(new document_type(capa, _allocator),
+                                          0);
+  }
+
+ private:
+  Entry* _entries;
+  size_t _size;   // number of entries
+  size_t _count;  // number of entries per capacity class
+  std::atomic<size_t> _next;
+  TAllocator _allocator;
+};
+
+typedef BasicJsonDocumentPool<DefaultAllocator> JsonDocumentPool;
+
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#endif
@@ -0,0 +1,217 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include "../Namespace.hpp"
+
+#include <stddef.h>  // size_t
+#include <string.h>  // memcpy
+
+#if ARDUINOJSON_SIMD_ISA == 2
+#include <immintrin.h>  // AVX2
+#elif ARDUINOJSON_SIMD_ISA == 1
+#include <emmintrin.h>  // SSE2
+#elif ARDUINOJSON_SIMD_ISA == 3
+#include <arm_neon.h>
+#endif
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// The scanners below skip whole blocks of characters that the parser would
+// otherwise read one at a time: the plain characters of a quoted string, and
+// the spaces between the tokens.
+// They return the offset of the first block that contains another character,
+// and the count functions find the exact position in that block.
+
+// Word at a time: a byte of v is zero iff the high bit of the result is set
+// (see "Determine if a word has a zero byte" in Bit Twiddling Hacks)
+inline bool hasZeroByte(size_t v) {
+  const size_t ones = size_t(-1) / 255;  // 0x0101...
+  return ((v - ones) & ~v & (ones << 7)) != 0;
+}
+
+inline size_t skipPlainWords(const char* s, size_t n, char stopChar) {
+  const size_t ones = size_t(-1) / 255;
+  const size_t quotes = ones * static_cast<unsigned char>(stopChar);
+  const size_t backslashes = ones * static_cast<unsigned char>('\\');
+  size_t i = 0;
+  for (; i + sizeof(size_t) <= n; i += sizeof(size_t)) {
+    size_t v;
+    memcpy(&v, s + i, sizeof(v));
+    if (hasZeroByte(v) || hasZeroByte(v ^ quotes) ||
+        hasZeroByte(v ^ backslashes))
+      break;
+  }
+  return i;
+}
+
+// Indentation is made of runs of the same character, so the words that are
+// all spaces or all tabs are enough; the scalar loop handles the rest
+inline size_t skipSpaceWords(const char* s, size_t n) {
+  const size_t ones = size_t(-1) / 255;
+  const size_t spaces = ones * static_cast<unsigned char>(' ');
+  const size_t tabs = ones * static_cast<unsigned char>('\t');
+  size_t i = 0;
+  for (; i + sizeof(size_t) <= n; i += sizeof(size_t)) {
+    size_t v;
+    memcpy(&v, s + i, sizeof(v));
+    if (v != spaces && v != tabs) break;
+  }
+  return i;
+}
+
+#if ARDUINOJSON_SIMD_ISA == 2  // AVX2
+inline size_t skipPlainBlocks(const char* s, size_t n, char stopChar) {
+  const __m256i quotes = _mm256_set1_epi8(stopChar);
+  const __m256i backslashes = _mm256_set1_epi8('\\');
+  const __m256i zeros = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+    __m256i m = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, quotes),
+                        _mm256_cmpeq_epi8(v, backslashes)),
+        _mm256_cmpeq_epi8(v, zeros));
+    if (_mm256_movemask_epi8(m)) break;
+  }
+  return i;
+}
+
+inline size_t skipSpaceBlocks(const char* s, size_t n) {
+  const __m256i spaces = _mm256_set1_epi8(' ');
+  const __m256i tabs = _mm256_set1_epi8('\t');
+  const __m256i crs = _mm256_set1_epi8('\r');
+  const __m256i lfs = _mm256_set1_epi8('\n');
+  size_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+    __m256i m = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, spaces),
+                        _mm256_cmpeq_epi8(v, tabs)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(v, crs), _mm256_cmpeq_epi8(v, lfs)));
+    if (_mm256_movemask_epi8(m) != -1) break;
+  }
+  return i;
+}
+#elif ARDUINOJSON_SIMD_ISA == 1  // SSE2
+inline size_t skipPlainBlocks(const char* s, size_t n, char stopChar) {
+  const __m128i quotes = _mm_set1_epi8(stopChar);
+  const __m128i backslashes = _mm_set1_epi8('\\');
+  const __m128i zeros = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quotes),
+                                          _mm_cmpeq_epi8(v, backslashes)),
+                             _mm_cmpeq_epi8(v, zeros));
+    if (_mm_movemask_epi8(m)) break;
+  }
+  return i;
+}
+
+inline size_t skipSpaceBlocks(const char* s, size_t n) {
+  const __m128i spaces = _mm_set1_epi8(' ');
+  const __m128i tabs = _mm_set1_epi8('\t');
+  const __m128i crs = _mm_set1_epi8('\r');
+  const __m128i lfs = _mm_set1_epi8('\n');
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    __m128i m = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(v, spaces), _mm_cmpeq_epi8(v, tabs)),
+        _mm_or_si128(_mm_cmpeq_epi8(v, crs), _mm_cmpeq_epi8(v, lfs)));
+    if (_mm_movemask_epi8(m) != 0xFFFF) break;
+  }
+  return i;
+}
+#elif ARDUINOJSON_SIMD_ISA == 3  // NEON
+inline size_t skipPlainBlocks(const char* s, size_t n, char stopChar) {
+  const uint8x16_t quotes = vdupq_n_u8(static_cast<uint8_t>(stopChar));
+  const uint8x16_t backslashes = vdupq_n_u8('\\');
+  const uint8x16_t zeros = vdupq_n_u8(0);
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(s + i));
+    uint8x16_t m = vorrq_u8(
+        vorrq_u8(vceqq_u8(v, quotes), vceqq_u8(v, backslashes)),
+        vceqq_u8(v, zeros));
+    uint64x2_t w = vreinterpretq_u64_u8(m);
+    if (vgetq_lane_u64(w, 0) | vgetq_lane_u64(w, 1)) break;
+  }
+  return i;
+}
+
+inline size_t skipSpaceBlocks(const char* s, size_t n) {
+  const uint8x16_t spaces = vdupq_n_u8(' ');
+  const uint8x16_t tabs = vdupq_n_u8('\t');
+  const uint8x16_t crs = vdupq_n_u8('\r');
+  const uint8x16_t lfs = vdupq_n_u8('\n');
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(s + i));
+    uint8x16_t m =
+        vorrq_u8(vorrq_u8(vceqq_u8(v, spaces), vceqq_u8(v, tabs)),
+                 vorrq_u8(vceqq_u8(v, crs), vceqq_u8(v, lfs)));
+    uint64x2_t w = vreinterpretq_u64_u8(m);
+    if (~(vgetq_lane_u64(w, 0) & vgetq_lane_u64(w, 1))) break;
+  }
+  return i;
+}
+#else
+inline size_t skipPlainBlocks(const char* s, size_t n, char stopChar) {
+  return skipPlainWords(s, n, stopChar);
+}
+
+inline size_t skipSpaceBlocks(const char* s, size_t n) {
+  return skipSpaceWords(s, n);
+}
+#endif
+
+// Returns the number of characters before the first stopChar, backslash or
+// NUL in the n characters of s, or n if there is none
+inline size_t countPlainChars(const char* s, size_t n, char stopChar) {
+#if ARDUINOJSON_ENABLE_SIMD
+  size_t i = skipPlainBlocks(s, n, stopChar);
+#else
+  size_t i = 0;
+#endif
+  while (i < n && s[i] != stopChar && s[i] != '\\' && s[i] != '\0') i++;
+  return i;
+}
+
+// Same, for a NUL-terminated string, which can't be read by blocks because
+// its size is unknown
+inline size_t countPlainChars(const char* s, char stopChar) {
+  size_t i = 0;
+  while (s[i] != stopChar && s[i] != '\\' && s[i] != '\0') i++;
+  return i;
+}
+
+inline bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Returns the number of spaces, tabs, CRs and LFs at the beginning of the n
+// characters of s
+inline size_t countSpaces(const char* s, size_t n) {
+  size_t i = 0;
+  while (i < n && isSpace(s[i])) {
+    i++;
+#if ARDUINOJSON_ENABLE_SIMD
+    // most runs are a few characters long, too short for the blocks
+    if (i == 16) i += skipSpaceBlocks(s + i, n - i);
+#endif
+  }
+  return i;
+}
+
+// Same, for a NUL-terminated string
+inline size_t countSpaces(const char* s) {
+  size_t i = 0;
+  while (isSpace(s[i])) i++;
+  return i;
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
@@ -4,11 +4,13 @@
 
 #pragma once
 
+#include "../Array/TypedArrayBuilder.hpp"
 #include "../Deserialization/deserialize.hpp"
 #include "../Memory/MemoryPool.hpp"
 #include "../Numbers/parseNumber.hpp"
 #include "../Polyfills/type_traits.hpp"
 #include "../Variant/VariantData.hpp"
+#include "CharScanner.hpp"
 #include "EscapeSequence.hpp"
 #include "Utf8.hpp"
 
@@ -38,6 +40,16 @@ class JsonDeserializer {
     return err;
   }
 
+  // Returns the number of bytes that parse() would take from the pool, when
+  // TStringStorage is a PoolSizeCounter (see measureDeserializeJson()).
+  // When the input is invalid, the count stops at the error, so that
+  // deserializeJson() reports that error rather than NoMemory.
+  size_t measure() {
+    VariantSizeCounter variant(&_stringStorage);
+    parseVariant(variant);
+    return _stringStorage.size();
+  }
+
  private:
   JsonDeserializer &operator=(const JsonDeserializer &);  // non-copiable
 
@@ -60,13 +72,14 @@ class JsonDeserializer {
     return true;
   }
 
-  DeserializationError parseVariant(VariantData &variant) {
+  template <typename TVariant>
+  DeserializationError parseVariant(TVariant &variant) {
     DeserializationError err = skipSpacesAndComments();
     if (err) return err;
 
     switch (current()) {
       case '[':
-        return parseArray(variant.toArray());
+        return parseArray(variant, variant.toArray());
 
       case '{':
         return parseObject(variant.toObject());
@@ -80,7 +93,8 @@ class JsonDeserializer {
     }
   }
 
-  DeserializationError parseArray(CollectionData &array) {
+  template <typename TVariant, typename TCollection>
+  DeserializationError parseArray(TVariant &variant, TCollection &array) {
     if (_nestingLimit == 0) return DeserializationError::TooDeep;
 
     // Check opening braket
@@ -93,16 +107,22 @@ class JsonDeserializer {
     // Empty array?
     if (eat(']')) return DeserializationError::Ok;
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (canBeginNumber(current()))
+      return parseTypedArray(variant, typedArrayBuilder(variant));
+#else
+    (void)variant;
+#endif
+
+    return parseElements(array);
+  }
+
+  template <typename TCollection>
+  DeserializationError parseElements(TCollection &array) {
     // Read each value
     for (;;) {
-      // Allocate slot in array
-      VariantData *value = array.add(_pool);
-      if (!value) return DeserializationError::NoMemory;
-
       // 1 - Parse value
-      _nestingLimit--;
-      err = parseVariant(*value);
-      _nestingLimit++;
+      DeserializationError err = parseElement(array.add(_pool));
       if (err) return err;
 
       // 2 - Skip spaces
@@ -115,7 +135,86 @@ class JsonDeserializer {
     }
   }
 
-  DeserializationError parseObject(CollectionData &object) {
+  template <typename TVariant>
+  DeserializationError parseElement(TVariant *value) {
+    if (!value) return DeserializationError::NoMemory;
+
+    _nestingLimit--;
+    DeserializationError err = parseVariant(*value);
+    _nestingLimit++;
+    return err;
+  }
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  TypedArrayBuilder typedArrayBuilder(VariantData &) {
+    return TypedArrayBuilder(_pool);
+  }
+
+  TypedArraySizeCounter typedArrayBuilder(VariantSizeCounter &) {
+    return TypedArraySizeCounter();
+  }
+
+  // Packs the numbers of an array in a typed array.
+  // If the array contains something else, the numbers read so far are moved
+  // to slots, and the parsing continues with parseElements().
+  template <typename TVariant, typename TBuilder>
+  DeserializationError parseTypedArray(TVariant &variant, TBuilder builder) {
+    for (;;) {
+      if (!canBeginNumber(current())) {
+        variant.setTypedArray(builder.complete());
+        if (!variant.expandTypedArray(_pool))
+          return DeserializationError::NoMemory;
+        return parseElements(*variant.asArray());
+      }
+
+      char buffer[64];
+      readUnquotedValue(buffer);
+      ParsedNumber<Float, UInt> num = parseNumber<Float, UInt>(buffer);
+      if (num.type() == VALUE_IS_NULL)
+        return DeserializationError::InvalidInput;
+
+      if (!builder.canStore(num)) {
+        variant.setTypedArray(builder.complete());
+        if (!variant.expandTypedArray(_pool))
+          return DeserializationError::NoMemory;
+        return parseNextElements(*variant.asArray(), num);
+      }
+
+      if (!builder.append(num)) return DeserializationError::NoMemory;
+
+      DeserializationError err = skipSpacesAndComments();
+      if (err) return err;
+
+      if (eat(']')) {
+        variant.setTypedArray(builder.complete());
+        return DeserializationError::Ok;
+      }
+      if (!eat(',')) return DeserializationError::InvalidInput;
+
+      err = skipSpacesAndComments();
+      if (err) return err;
+    }
+  }
+
+  // Adds the number that doesn't fit in the typed array, and the elements
+  // that follow
+  template <typename TCollection>
+  DeserializationError parseNextElements(
+      TCollection &array, const ParsedNumber<Float, UInt> &num) {
+    DeserializationError err = addNumber(array.add(_pool), num);
+    if (err) return err;
+
+    err = skipSpacesAndComments();
+    if (err) return err;
+
+    if (eat(']')) return DeserializationError::Ok;
+    if (!eat(',')) return DeserializationError::InvalidInput;
+    return parseElements(array);
+  }
+#endif
+
+  template <typename TCollection>
+  DeserializationError parseObject(TCollection &object) {
     if (_nestingLimit == 0) return DeserializationError::TooDeep;
 
     // Check opening brace
@@ -130,25 +229,8 @@ class JsonDeserializer {
 
     // Read each key value pair
     for (;;) {
-      // Allocate slot in object
-      VariantSlot *slot = object.addSlot(_pool);
-      if (!slot) return DeserializationError::NoMemory;
-
-      // Parse key
-      const char *key;
-      err = parseKey(key);
-      if (err) return err;
-      slot->setOwnedKey(make_not_null(key));
-
-      // Skip spaces
-      err = skipSpacesAndComments();
-      if (err) return err;  // Colon
-      if (!eat(':')) return DeserializationError::InvalidInput;
-
-      // Parse value
-      _nestingLimit--;
-      err = parseVariant(*slot->data());
-      _nestingLimit++;
+      // Parse key and value
+      err = parseMember(object.addSlot(_pool));
       if (err) return err;
 
       // Skip spaces
@@ -165,28 +247,55 @@ class JsonDeserializer {
     }
   }
 
-  DeserializationError parseKey(const char *&key) {
-    if (isQuote(current())) {
-      return parseQuotedString(key);
-    } else {
-      return parseNonQuotedString(key);
-    }
+  template <typename TSlot>
+  DeserializationError parseMember(TSlot *slot) {
+    if (!slot) return DeserializationError::NoMemory;
+
+    // Parse key
+    const char *key;
+    DeserializationError err = parseKey(key);
+    if (err) return err;
+    slot->setOwnedKey(make_not_null(_pool->internKey(key)));
+
+    // Skip spaces
+    err = skipSpacesAndComments();
+    if (err) return err;  // Colon
+    if (!eat(':')) return DeserializationError::InvalidInput;
+
+    // Parse value
+    _nestingLimit--;
+    err = parseVariant(*slot->data());
+    _nestingLimit++;
+    return err;
   }
 
-  DeserializationError parseStringValue(VariantData &variant) {
-    const char *value;
-    DeserializationError err = parseQuotedString(value);
+  DeserializationError parseKey(const char *&key) {
+    StringBuilder builder = _stringStorage.startString();
+    DeserializationError err = isQuote(current())
+                                   ? parseQuotedString(builder)
+                                   : parseNonQuotedString(builder);
     if (err) return err;
-    variant.setOwnedString(make_not_null(value));
+    key = builder.complete();  // keys are C strings
+    if (!key) return DeserializationError::NoMemory;
     return DeserializationError::Ok;
   }
 
-  DeserializationError parseQuotedString(const char *&result) {
+  template <typename TVariant>
+  DeserializationError parseStringValue(TVariant &variant) {
     StringBuilder builder = _stringStorage.startString();
+    DeserializationError err = parseQuotedString(builder);
+    if (err) return err;
+    if (!saveStringValue(variant, builder, _pool))
+      return DeserializationError::NoMemory;
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError parseQuotedString(StringBuilder &builder) {
     const char stopChar = current();
 
     move();
     for (;;) {
+      readPlainChars(builder, stopChar);
       char c = current();
       move();
       if (c == stopChar) break;
@@ -217,14 +326,46 @@ class JsonDeserializer {
       builder.append(c);
     }
 
-    result = builder.complete();
-    if (!result) return DeserializationError::NoMemory;
     return DeserializationError::Ok;
   }
 
-  DeserializationError parseNonQuotedString(const char *&result) {
-    StringBuilder builder = _stringStorage.startString();
+  // Appends the characters that need no decoding, straight from the input,
+  // if the reader supports peekSpan()
+  void readPlainChars(StringBuilder &builder, char stopChar) {
+    readPlainChars(
+        builder, stopChar,
+        integral_constant<bool, ReaderTraits<TReader>::hasPeekSpan>());
+  }
 
+  void readPlainChars(StringBuilder &builder, char stopChar, true_type) {
+    if (_loaded) return;
+    size_t size;
+    const char *s = _reader.peekSpan(size);
+    // an unbounded span may end right after the NUL, so read it char by char
+    size_t n = size == size_t(-1) ? countPlainChars(s, stopChar)
+                                  : countPlainChars(s, size, stopChar);
+    if (!n) return;
+    builder.append(s, n);
+    _reader.skip(n);
+  }
+
+  void readPlainChars(StringBuilder &, char, false_type) {}
+
+  // Skips a run of spaces in place, when the reader exposes its buffer
+  void skipSpaces() {
+    skipSpaces(integral_constant<bool, ReaderTraits<TReader>::hasPeekSpan>());
+  }
+
+  void skipSpaces(true_type) {
+    if (_loaded) return;
+    size_t size;
+    const char *s = _reader.peekSpan(size);
+    _reader.skip(size == size_t(-1) ? countSpaces(s) : countSpaces(s, size));
+  }
+
+  void skipSpaces(false_type) {}
+
+  DeserializationError parseNonQuotedString(StringBuilder &builder) {
     char c = current();
     if (c == '\0') return DeserializationError::IncompleteInput;
 
@@ -238,13 +379,11 @@ class JsonDeserializer {
       return DeserializationError::InvalidInput;
     }
 
-    result = builder.complete();
-    if (!result) return DeserializationError::NoMemory;
     return DeserializationError::Ok;
   }
 
-  DeserializationError parseNumericValue(VariantData &result) {
-    char buffer[64];
+  // Reads a number, a boolean or null; returns the number of characters
+  uint8_t readUnquotedValue(char (&buffer)[64]) {
     uint8_t n = 0;
 
     char c = current();
@@ -254,8 +393,15 @@ class JsonDeserializer {
       c = current();
     }
     buffer[n] = 0;
+    return n;
+  }
+
+  template <typename TVariant>
+  DeserializationError parseNumericValue(TVariant &result) {
+    char buffer[64];
+    uint8_t n = readUnquotedValue(buffer);
 
-    c = buffer[0];
+    char c = buffer[0];
     if (c == 't') {  // true
       result.setBoolean(true);
       return n == 4 ? DeserializationError::Ok
@@ -273,22 +419,36 @@ class JsonDeserializer {
     }
 
     ParsedNumber<Float, UInt> num = parseNumber<Float, UInt>(buffer);
+    if (num.type() == VALUE_IS_NULL) return DeserializationError::InvalidInput;
 
+    setNumber(result, num);
+    return DeserializationError::Ok;
+  }
+
+  template <typename TVariant>
+  static DeserializationError addNumber(TVariant *value,
+                                        const ParsedNumber<Float, UInt> &num) {
+    if (!value) return DeserializationError::NoMemory;
+    setNumber(*value, num);
+    return DeserializationError::Ok;
+  }
+
+  template <typename TVariant>
+  static void setNumber(TVariant &variant,
+                        const ParsedNumber<Float, UInt> &num) {
     switch (num.type()) {
       case VALUE_IS_NEGATIVE_INTEGER:
-        result.setNegativeInteger(num.uintValue);
-        return DeserializationError::Ok;
+        variant.setNegativeInteger(num.uintValue);
+        break;
 
       case VALUE_IS_POSITIVE_INTEGER:
-        result.setPositiveInteger(num.uintValue);
-        return DeserializationError::Ok;
+        variant.setPositiveInteger(num.uintValue);
+        break;
 
       case VALUE_IS_FLOAT:
-        result.setFloat(num.floatValue);
-        return DeserializationError::Ok;
+        variant.setFloat(num.floatValue);
+        break;
     }
-
-    return DeserializationError::InvalidInput;
   }
 
   DeserializationError parseCodepoint(uint16_t &codepoint) {
@@ -313,6 +473,10 @@ class JsonDeserializer {
            isBetween(c, 'A', 'Z') || c == '+' || c == '-' || c == '.';
   }
 
+  static inline bool canBeginNumber(char c) {
+    return isBetween(c, '0', '9') || c == '-' || c == '+' || c == '.';
+  }
+
   static inline bool isQuote(char c) {
     return c == '\'' || c == '\"';
   }
@@ -325,6 +489,7 @@ class JsonDeserializer {
 
   DeserializationError skipSpacesAndComments() {
     for (;;) {
+      skipSpaces();
       switch (current()) {
         // end of string
         case '\0':
@@ -417,4 +582,30 @@ DeserializationError deserializeJson(
     NestingLimit nestingLimit = NestingLimit()) {
   return deserialize<JsonDeserializer>(doc, input, nestingLimit);
 }
+
+// Returns the capacity of the JsonDocument that deserializeJson() needs for
+// this input; reads the input without building anything
+template <typename TInput>
+size_t measureDeserializeJson(const TInput &input,
+                              NestingLimit nestingLimit = NestingLimit()) {
+  return measureDeserialize<JsonDeserializer>(input, nestingLimit);
+}
+
+template <typename TInput>
+size_t measureDeserializeJson(TInput *input,
+                              NestingLimit nestingLimit = NestingLimit()) {
+  return measureDeserialize<JsonDeserializer>(input, nestingLimit);
+}
+
+template <typename TInput>
+size_t measureDeserializeJson(TInput *input, size_t inputSize,
+                              NestingLimit nestingLimit = NestingLimit()) {
+  return measureDeserialize<JsonDeserializer>(input, inputSize, nestingLimit);
+}
+
+template <typename TInput>
+size_t measureDeserializeJson(TInput &input,
+                              NestingLimit nestingLimit = NestingLimit()) {
+  return measureDeserialize<JsonDeserializer>(input, nestingLimit);
+}
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -33,6 +33,17 @@ class JsonSerializer {
     write(']');
   }
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  void visitTypedArray(const TypedArray &array) {
+    write('[');
+    for (size_t i = 0; i < array.size(); i++) {
+      if (i) write(',');
+      array.acceptElement(i, *this);
+    }
+    write(']');
+  }
+#endif
+
   void visitObject(const CollectionData &object) {
     write('{');
 
@@ -60,6 +71,10 @@ class JsonSerializer {
     _formatter.writeString(value);
   }
 
+  void visitString(const char *value, size_t n) {
+    _formatter.writeString(value, n);
+  }
+
   void visitRawJson(const char *data, size_t n) {
     _formatter.writeRaw(data, n);
   }
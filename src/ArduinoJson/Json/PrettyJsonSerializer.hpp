@@ -36,6 +36,23 @@ class PrettyJsonSerializer : public JsonSerializer<TWriter> {
     base::write("]");
   }
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  void visitTypedArray(const TypedArray &array) {
+    if (!array.size()) return base::write("[]");
+
+    base::write("[\r\n");
+    _nesting++;
+    for (size_t i = 0; i < array.size(); i++) {
+      indent();
+      array.acceptElement(i, *this);
+      base::write(i + 1 < array.size() ? ",\r\n" : "\r\n");
+    }
+    _nesting--;
+    indent();
+    base::write("]");
+  }
+#endif
+
   void visitObject(const CollectionData &object) {
     VariantSlot *slot = object.head();
     if (!slot) return base::write("{}");
@@ -6,13 +6,44 @@
 
 #include "../Polyfills/assert.hpp"
 #include "../Polyfills/mpl/max.hpp"
+#include "../Strings/StringHash.hpp"
 #include "../Variant/VariantSlot.hpp"
 #include "Alignment.hpp"
-#include "MemoryPool.hpp"
+#include "MemoryPoolMove.hpp"
 #include "StringSlot.hpp"
 
+#include <string.h>  // memcpy, strlen
+
 namespace ARDUINOJSON_NAMESPACE {
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+// The functions a growable MemoryPool calls to get extra blocks
+struct MemoryBlockAllocator {
+  void* (*allocate)(void* context, size_t);
+  void (*deallocate)(void* context, void*);
+  void* context;
+};
+
+// Header at the beginning of each extra block
+struct MemoryBlock {
+  MemoryBlock* previous;
+  char* end;
+};
+#endif
+
+#if ARDUINOJSON_ENABLE_POOL_STATS
+// A breakdown of the memory usage (see MemoryPool::stats())
+// stringBytes + slotBytes - freeBytes == memoryUsage()
+struct MemoryPoolStats {
+  size_t stringBytes;  // strings, typed arrays, and interning table
+  size_t slotBytes;    // slots and collection indexes
+  size_t slotCount;    // slots in use, including those leaked by remove()
+  size_t freeBytes;    // released memory in the free lists
+  size_t deadBytes;    // leaked memory, that garbageCollect() would reclaim
+  size_t peakUsage;    // the highest memoryUsage(), even before clear()
+};
+#endif
+
 // _begin                                _end
 // v                                        v
 // +-------------+--------------+-----------+
@@ -20,6 +51,14 @@ namespace ARDUINOJSON_NAMESPACE {
 // +-------------+--------------+-----------+
 //               ^              ^
 //             _left          _right
+//
+// When ARDUINOJSON_ENABLE_GROWABLE_POOL is set, and a MemoryBlockAllocator
+// is attached, a full pool chains a new block and continues there.
+// The previous blocks are kept until clear().
+//
+// When ARDUINOJSON_ENABLE_FREE_LISTS is set, the released slots and strings
+// are linked in free lists, and the next allocations reuse them.
+// The link is stored in the released memory itself.
 
 class MemoryPool {
  public:
@@ -31,27 +70,179 @@ class MemoryPool {
     ARDUINOJSON_ASSERT(isAligned(_begin));
     ARDUINOJSON_ASSERT(isAligned(_right));
     ARDUINOJSON_ASSERT(isAligned(_end));
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    _buffer = _begin;
+    _bufferEnd = _end;
+    _blocks = 0;
+    _retiredStrings = 0;
+    _retiredSlots = 0;
+    _retiredCapacity = 0;
+    _blockAllocator.allocate = 0;
+    _blockAllocator.deallocate = 0;
+    _blockAllocator.context = 0;
+#endif
+    clearFreeLists();
+    clearInternTable();
+#if ARDUINOJSON_ENABLE_POOL_STATS
+    _slotCount = 0;
+    _peakUsage = 0;
+#endif
   }
 
   void* buffer() {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    return _buffer;
+#else
     return _begin;
+#endif
   }
 
   // Gets the capacity of the memoryPool in bytes
   size_t capacity() const {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    return _retiredCapacity + size_t(_end - _begin);
+#else
     return size_t(_end - _begin);
+#endif
   }
 
   size_t size() const {
-    return size_t(_left - _begin + _end - _right);
+    return stringZoneSize() + slotZoneSize() - freeSize();
   }
 
+  // The capacity once squashed: the strings, the padding, and the slots
+  size_t squashedCapacity() const {
+    return addPadding(size_t(_left - _begin)) + size_t(_end - _right);
+  }
+
+  // Copies the strings, then the slots, to a buffer of squashedCapacity()
+  // bytes, which can be the current one. The pool still refers to the old
+  // places, until relocate().
+  MemoryPoolMove squashTo(char* buffer) {
+    size_t strings = size_t(_left - _begin);
+    char* slots = buffer + addPadding(strings);
+    MemoryPoolMove move;
+    move.stringsBegin = reinterpret_cast<size_t>(_begin);
+    move.stringsEnd = reinterpret_cast<size_t>(_left);
+    move.slotsBegin = reinterpret_cast<size_t>(_right);
+    move.slotsEnd = reinterpret_cast<size_t>(_end);
+    move.stringDistance = reinterpret_cast<size_t>(buffer) - move.stringsBegin;
+    move.slotDistance = reinterpret_cast<size_t>(slots) - move.slotsBegin;
+    memmove(buffer, _begin, strings);
+    memmove(slots, _right, size_t(_end - _right));
+    return move;
+  }
+
+  // Updates the pool, and the links it stores, after squashTo()
+  void relocate(const MemoryPoolMove& move) {
+    _begin = move.moveString(_begin);
+    _left = move.moveString(_left);
+    _right = move.moveSlot(_right);
+    _end = move.moveSlot(_end);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    ARDUINOJSON_ASSERT(!_blocks);
+    _buffer = _begin;
+    _bufferEnd = _end;
+#endif
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    relocateList(_freeSlots, move);
+    for (size_t i = 0; i < freeStringClasses; i++)
+      relocateList(_freeStrings[i], move);
+#endif
+#if ARDUINOJSON_STRING_INTERNING
+    _internBuckets = move.relocate(_internBuckets);
+    for (size_t i = 0; i < _internBucketCount; i++) {
+      char* node = relocateLink(_internBuckets + i * sizeof(char*), move);
+      for (; node; node = relocateLink(node, move))
+        relocateLink(node + sizeof(char*), move);
+    }
+#endif
+    checkInvariants();
+  }
+
+#if ARDUINOJSON_ENABLE_POOL_STATS
+  // The deadBytes member is left to zero, because only the owner of the
+  // tree can tell which bytes are still in use (see JsonDocument).
+  MemoryPoolStats stats() {
+    updatePeakUsage();
+    MemoryPoolStats s;
+    s.stringBytes = stringZoneSize();
+    s.slotBytes = slotZoneSize();
+    s.slotCount = _slotCount;
+    s.freeBytes = freeSize();
+    s.deadBytes = 0;
+    s.peakUsage = _peakUsage;
+    return s;
+  }
+#endif
+
   VariantSlot* allocVariant() {
-    return allocRight<VariantSlot>();
+    VariantSlot* slot = allocFreeSlot();
+    if (!slot) slot = allocRight<VariantSlot>();
+#if ARDUINOJSON_ENABLE_POOL_STATS
+    if (slot) _slotCount++;
+#endif
+    return slot;
+  }
+
+  // Gives a slot back to the pool.
+  // The slot's next offset is preserved, so an iterator can move past it.
+  void freeVariant(VariantSlot* slot) {
+#if ARDUINOJSON_ENABLE_POOL_STATS
+    _slotCount--;
+#endif
+    freeSlotZone(slot, sizeof(VariantSlot));
+  }
+
+  // Gives back n bytes of the slot zone that don't hold a slot, like a
+  // CollectionIndex; n must be a multiple of sizeof(VariantSlot).
+  void freeSlotZone(void* p, size_t n) {
+    ARDUINOJSON_ASSERT(n % sizeof(VariantSlot) == 0);
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    updatePeakUsage();
+    for (char* slot = static_cast<char*>(p); n; n -= sizeof(VariantSlot)) {
+      writeLink(slot, _freeSlots);
+      _freeSlots = slot;
+      _freeSize += sizeof(VariantSlot);
+      slot += sizeof(VariantSlot);
+    }
+#else
+    (void)p;
+    (void)n;
+#endif
+  }
+
+  // Bytes taken from the right of the blocks
+  size_t slotZoneSize() const {
+    size_t n = size_t(_end - _right);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    n += _retiredSlots;
+#endif
+    return n;
+  }
+
+  // Gives back the slots allocated since slotZoneSize() was n, which must all
+  // come from allocVariant() with empty free lists. Nothing must point to
+  // them anymore. When a block was chained in between, they are lost.
+  void rewindSlotZone(size_t n) {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    if (n < _retiredSlots) return;
+    n -= _retiredSlots;
+#endif
+    ARDUINOJSON_ASSERT(n <= size_t(_end - _right));
+#if ARDUINOJSON_ENABLE_POOL_STATS
+    _slotCount -= (size_t(_end - _right) - n) / sizeof(VariantSlot);
+#endif
+    _right = _end - n;
   }
 
   char* allocFrozenString(size_t n) {
-    if (!canAlloc(n)) return 0;
+    n = stringSize(n);
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    char* recycled = allocFreeString(n);
+    if (recycled) return recycled;
+#endif
+    if (!canAlloc(n) && !grow(n)) return 0;
     char* s = _left;
     _left += n;
     checkInvariants();
@@ -67,6 +258,87 @@ class MemoryPool {
     return s;
   }
 
+  // Moves the expandable string to a new block, if the pool can grow.
+  // Returns false if the pool is full.
+  bool growExpandableString(StringSlot& s, size_t usedSize) {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    _left = s.value;  // give back the unused part
+    if (!grow(usedSize + 1)) {
+      _left = _right;
+      return false;
+    }
+    memcpy(_left, s.value, usedSize);
+    s = allocExpandableString();
+    return true;
+#else
+    (void)s;
+    (void)usedSize;
+    return false;
+#endif
+  }
+
+  // Returns the number of bytes that a string of n bytes takes in the pool.
+  // With ARDUINOJSON_ENABLE_FREE_LISTS, a string takes at least the size of
+  // the free list header, so that freeString() can recycle it.
+  static size_t stringSize(size_t n) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    return n && n < minFreeStringSize ? minFreeStringSize : n;
+#else
+    return n;
+#endif
+  }
+
+  // Gives a string of n bytes back to the pool.
+  // Strings that don't belong to the pool (see StringMover) are ignored.
+  void freeString(const char* s, size_t n) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    n = stringSize(n);
+    if (!n || !owns(s)) return;
+    updatePeakUsage();
+    pushFreeString(const_cast<char*>(s), n);
+    _freeSize += n;
+#else
+    (void)s;
+    (void)n;
+#endif
+  }
+
+  // Gives back a string of n bytes that has just been allocated.
+  // Strings that don't belong to the pool (see StringMover) are ignored.
+  void releaseString(const char* s, size_t n) {
+    n = stringSize(n);
+    if (s + n == _left && owns(s)) {
+      updatePeakUsage();
+      _left -= n;
+    } else {
+      freeString(s, n);
+    }
+  }
+
+  // Returns the shared copy of a key that has just been saved in the pool.
+  // If the pool already contains this string, the new copy is given back.
+  // Call it before allocating another string, so that the copy is still at
+  // _left; otherwise, without free lists, releaseString() can't reclaim it.
+  const char* internKey(const char* s) {
+#if ARDUINOJSON_STRING_INTERNING >= 1
+    return internString(s);
+#else
+    return s;
+#endif
+  }
+
+  // Same as internKey(), for a string value of n characters
+  const char* internValue(const char* s, size_t n) {
+#if ARDUINOJSON_STRING_INTERNING >= 2
+    // the table holds C strings, so a value with a NUL inside stays apart
+    if (strlen(s) != n) return s;
+    return internString(s);
+#else
+    (void)n;
+    return s;
+#endif
+  }
+
   void freezeString(StringSlot& s, size_t newSize) {
     _left -= (s.size - newSize);
     s.size = newSize;
@@ -74,17 +346,53 @@ class MemoryPool {
   }
 
   void clear() {
+    updatePeakUsage();
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    releaseBlocks();
+#endif
     _left = _begin;
     _right = _end;
+    clearFreeLists();
+    clearInternTable();
+#if ARDUINOJSON_ENABLE_POOL_STATS
+    _slotCount = 0;
+#endif
   }
 
   bool canAlloc(size_t bytes) const {
     return _left + bytes <= _right;
   }
 
-  bool owns(void* p) const {
+  bool owns(const void* p) const {
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    if (_buffer <= p && p < _bufferEnd) return true;
+    for (MemoryBlock* b = _blocks; b; b = b->previous) {
+      if (static_cast<void*>(b + 1) <= p && p < b->end) return true;
+    }
+    return false;
+#else
     return _begin <= p && p < _end;
+#endif
+  }
+
+#if ARDUINOJSON_STRING_INTERNING
+  // Upper bound of the bytes taken by the interning table for n strings:
+  // a node per string, and the bucket tables, whose sizes double.
+  static size_t internTableSize(size_t n) {
+    return n ? (4 * n + minInternBuckets) * sizeof(char*) : 0;
+  }
+#endif
+
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  // Tells if extra blocks were chained, which squashTo() can't handle
+  bool hasBlocks() const {
+    return _blocks != 0;
+  }
+
+  void setBlockAllocator(const MemoryBlockAllocator& allocator) {
+    _blockAllocator = allocator;
   }
+#endif
 
   template <typename T>
   T* allocRight() {
@@ -92,11 +400,17 @@ class MemoryPool {
   }
 
   void* allocRight(size_t bytes) {
-    if (!canAlloc(bytes)) return 0;
+    if (!canAlloc(bytes) && !grow(bytes)) return 0;
     _right -= bytes;
     return _right;
   }
 
+  // Tells if p is the last block allocated with allocRight(), which the next
+  // allocRight() extends to the left if canAlloc() is true
+  bool isLastAllocRight(const void* p) const {
+    return p == _right;
+  }
+
   // Workaround for missing placement new
   void* operator new(size_t, void* p) {
     return p;
@@ -107,6 +421,51 @@ class MemoryPool {
     return allocRight<StringSlot>();
   }
 
+  VariantSlot* allocFreeSlot() {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    if (!_freeSlots) return 0;
+    char* slot = _freeSlots;
+    _freeSlots = readLink(slot);
+    _freeSize -= sizeof(VariantSlot);
+    return reinterpret_cast<VariantSlot*>(slot);
+#else
+    return 0;
+#endif
+  }
+
+  void clearFreeLists() {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    _freeSlots = 0;
+    for (size_t i = 0; i < freeStringClasses; i++) _freeStrings[i] = 0;
+    _freeSize = 0;
+#endif
+  }
+
+  // Bytes taken from the left of the blocks
+  size_t stringZoneSize() const {
+    size_t n = size_t(_left - _begin);
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+    n += _retiredStrings;
+#endif
+    return n;
+  }
+
+  size_t freeSize() const {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+    return _freeSize;
+#else
+    return 0;
+#endif
+  }
+
+  // Must be called before anything that reduces size()
+  void updatePeakUsage() {
+#if ARDUINOJSON_ENABLE_POOL_STATS
+    size_t n = size();
+    if (n > _peakUsage) _peakUsage = n;
+#endif
+  }
+
   void checkInvariants() {
     ARDUINOJSON_ASSERT(_begin <= _left);
     ARDUINOJSON_ASSERT(_left <= _right);
@@ -114,7 +473,232 @@ class MemoryPool {
     ARDUINOJSON_ASSERT(isAligned(_right));
   }
 
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  // Chains a new block that can hold at least the specified number of bytes.
+  // The block is at least as big as the whole pool, so the capacity doubles.
+  bool grow(size_t bytes) {
+    if (!_blockAllocator.allocate) return false;
+
+    size_t capa = addPadding(capacity() > bytes ? capacity() : bytes);
+    capa += sizeof(VariantSlot);  // room for slot alignment
+    void* p = _blockAllocator.allocate(_blockAllocator.context,
+                                       sizeof(MemoryBlock) + capa);
+    if (!p) return false;
+
+    MemoryBlock* block = static_cast<MemoryBlock*>(p);
+    char* begin = reinterpret_cast<char*>(block + 1);
+    char* end = alignSlotRegion(begin + capa);
+    block->previous = _blocks;
+    block->end = end;
+    _blocks = block;
+
+    _retiredStrings = stringZoneSize();
+    _retiredSlots = slotZoneSize();
+    _retiredCapacity = capacity();
+    _begin = _left = begin;
+    _right = _end = end;
+    checkInvariants();
+    return true;
+  }
+
+  // VariantSlot::_next counts in slots, so the distance between two slots
+  // must be a multiple of sizeof(VariantSlot), even across blocks.
+  char* alignSlotRegion(char* end) const {
+    if (!_end) return end;
+    const size_t slotSize = sizeof(VariantSlot);
+    size_t newEnd = reinterpret_cast<size_t>(end);
+    size_t oldEnd = reinterpret_cast<size_t>(_end);
+    size_t misalignment = newEnd >= oldEnd
+                              ? (newEnd - oldEnd) % slotSize
+                              : (slotSize - (oldEnd - newEnd) % slotSize) %
+                                    slotSize;
+    return end - misalignment;
+  }
+
+  void releaseBlocks() {
+    while (_blocks) {
+      MemoryBlock* previous = _blocks->previous;
+      _blockAllocator.deallocate(_blockAllocator.context, _blocks);
+      _blocks = previous;
+    }
+    _begin = _buffer;
+    _end = _bufferEnd;
+    _retiredStrings = 0;
+    _retiredSlots = 0;
+    _retiredCapacity = 0;
+  }
+#else
+  bool grow(size_t) {
+    return false;
+  }
+#endif
+
+  // The string zone is not aligned, so the pointers stored there are
+  // accessed with memcpy()
+  static char* readLink(const char* p) {
+    char* link;
+    memcpy(&link, p, sizeof(link));
+    return link;
+  }
+
+  static void writeLink(char* p, const char* link) {
+    memcpy(p, &link, sizeof(link));
+  }
+
+  // Updates the link stored at p, and returns it
+  static char* relocateLink(char* p, const MemoryPoolMove& move) {
+    char* link = move.relocate(readLink(p));
+    writeLink(p, link);
+    return link;
+  }
+
+  static void relocateList(char*& head, const MemoryPoolMove& move) {
+    head = move.relocate(head);
+    for (char* p = head; p;) p = relocateLink(p, move);
+  }
+
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  // A free string starts with the link and its size.
+  static const size_t minFreeStringSize = sizeof(char*) + sizeof(size_t);
+
+  // Free string lists by size class: class i holds the strings whose size is
+  // in [minFreeStringSize << i, minFreeStringSize << (i+1)).
+  static const size_t freeStringClasses = 8;
+
+  static size_t readFreeStringSize(const char* s) {
+    size_t n;
+    memcpy(&n, s + sizeof(char*), sizeof(n));
+    return n;
+  }
+
+  static size_t freeStringClass(size_t n) {
+    size_t i = 0;
+    while (i + 1 < freeStringClasses && (minFreeStringSize << (i + 1)) <= n)
+      i++;
+    return i;
+  }
+
+  void pushFreeString(char* s, size_t n) {
+    size_t i = freeStringClass(n);
+    writeLink(s, _freeStrings[i]);
+    memcpy(s + sizeof(char*), &n, sizeof(n));
+    _freeStrings[i] = s;
+  }
+
+  // Takes a free string of at least n bytes, and gives back the remainder
+  char* allocFreeString(size_t n) {
+    if (n < minFreeStringSize) return 0;
+    for (size_t i = freeStringClass(n); i < freeStringClasses; i++) {
+      char* previous = 0;
+      for (char* s = _freeStrings[i]; s; s = readLink(s)) {
+        size_t size = readFreeStringSize(s);
+        if (size >= n) {
+          if (previous)
+            writeLink(previous, readLink(s));
+          else
+            _freeStrings[i] = readLink(s);
+          _freeSize -= size;
+          if (size - n >= minFreeStringSize) freeString(s + n, size - n);
+          return s;
+        }
+        previous = s;
+      }
+    }
+    return 0;
+  }
+#endif
+
+#if ARDUINOJSON_STRING_INTERNING
+  // The interning table is a hash table in the string zone.
+  // Each node holds the link to the next node and the interned string.
+  static const size_t minInternBuckets = 8;
+
+  char* internBucket(size_t h) const {
+    return _internBuckets + (h & (_internBucketCount - 1)) * sizeof(char*);
+  }
+
+  const char* internString(const char* s) {
+    if (!owns(s)) return s;  // see StringMover
+
+    size_t n = strlen(s);
+    size_t h = hashString(s, n);
+    if (_internBucketCount) {
+      for (char* node = readLink(internBucket(h)); node; node = readLink(node)) {
+        const char* value = readLink(node + sizeof(char*));
+        if (!strcmp(value, s)) {
+          releaseString(s, n + 1);
+          return value;
+        }
+      }
+    }
+
+    if (_internCount >= 2 * _internBucketCount) growInternTable();
+    if (!_internBucketCount) return s;
+    char* node = allocFrozenString(2 * sizeof(char*));
+    if (!node) return s;
+    char* bucket = internBucket(h);
+    writeLink(node, readLink(bucket));
+    writeLink(node + sizeof(char*), s);
+    writeLink(bucket, node);
+    _internCount++;
+    return s;
+  }
+
+  // Doubles the number of buckets; keeps the current table if it fails
+  void growInternTable() {
+    size_t count = _internBucketCount ? 2 * _internBucketCount
+                                      : minInternBuckets;
+    char* buckets = allocFrozenString(count * sizeof(char*));
+    if (!buckets) return;
+    memset(buckets, 0, count * sizeof(char*));
+
+    char* oldBuckets = _internBuckets;
+    size_t oldCount = _internBucketCount;
+    _internBuckets = buckets;
+    _internBucketCount = count;
+
+    for (size_t i = 0; i < oldCount; i++) {
+      char* node = readLink(oldBuckets + i * sizeof(char*));
+      while (node) {
+        char* next = readLink(node);
+        const char* value = readLink(node + sizeof(char*));
+        char* bucket = internBucket(hashString(value, strlen(value)));
+        writeLink(node, readLink(bucket));
+        writeLink(bucket, node);
+        node = next;
+      }
+    }
+    if (oldBuckets) freeString(oldBuckets, oldCount * sizeof(char*));
+  }
+#endif
+
+  void clearInternTable() {
+#if ARDUINOJSON_STRING_INTERNING
+    _internBuckets = 0;
+    _internBucketCount = 0;
+    _internCount = 0;
+#endif
+  }
+
   char *_begin, *_left, *_right, *_end;
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+  char *_buffer, *_bufferEnd;
+  MemoryBlock* _blocks;
+  size_t _retiredStrings, _retiredSlots, _retiredCapacity;
+  MemoryBlockAllocator _blockAllocator;
+#endif
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  char* _freeSlots;
+  char* _freeStrings[freeStringClasses];
+  size_t _freeSize;
+#endif
+#if ARDUINOJSON_STRING_INTERNING
+  char* _internBuckets;
+  size_t _internBucketCount, _internCount;
+#endif
+#if ARDUINOJSON_ENABLE_POOL_STATS
+  size_t _slotCount, _peakUsage;
+#endif
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -0,0 +1,45 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // size_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Where the strings and the slots of a MemoryPool went, once squashed and
+// reallocated (see BasicJsonDocument::shrinkToFit()).
+// The addresses are integers, because the old buffer may be gone.
+struct MemoryPoolMove {
+  size_t stringsBegin, stringsEnd;      // the old string zone
+  size_t slotsBegin, slotsEnd;          // the old slot zone
+  size_t stringDistance, slotDistance;  // modulo arithmetic
+
+  // Returns the new address of p, if it points to one of the old zones
+  template <typename T>
+  T* relocate(T* p) const {
+    size_t addr = reinterpret_cast<size_t>(p);
+    if (stringsBegin <= addr && addr < stringsEnd) return moveString(p);
+    if (slotsBegin <= addr && addr < slotsEnd) return moveSlot(p);
+    return p;
+  }
+
+  template <typename T>
+  T* moveString(T* p) const {
+    return reinterpret_cast<T*>(reinterpret_cast<size_t>(p) + stringDistance);
+  }
+
+  template <typename T>
+  T* moveSlot(T* p) const {
+    return reinterpret_cast<T*>(reinterpret_cast<size_t>(p) + slotDistance);
+  }
+
+  // Adds the distance by which the whole buffer moved
+  void shift(size_t distance) {
+    stringDistance += distance;
+    slotDistance += distance;
+  }
+};
+
+}  // namespace ARDUINOJSON_NAMESPACE
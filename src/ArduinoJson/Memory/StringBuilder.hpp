@@ -6,6 +6,8 @@
 
 #include "MemoryPool.hpp"
 
+#include <string.h>  // memcpy
+
 namespace ARDUINOJSON_NAMESPACE {
 
 class StringBuilder {
@@ -19,13 +21,19 @@ class StringBuilder {
   }
 
   void append(const char* s, size_t n) {
-    while (n-- > 0) append(*s++);
+    if (!_slot.value) return;
+    // copy what fits in the current block, the rest may need a new one
+    size_t room = _slot.size - _size;
+    size_t bulk = n < room ? n : room;
+    memcpy(_slot.value + _size, s, bulk);
+    _size += bulk;
+    for (size_t i = bulk; i < n; i++) append(s[i]);
   }
 
   void append(char c) {
     if (!_slot.value) return;
 
-    if (_size >= _slot.size) {
+    if (_size >= _slot.size && !_parent->growExpandableString(_slot, _size)) {
       _slot.value = 0;
       return;
     }
@@ -33,14 +41,27 @@ class StringBuilder {
     _slot.value[_size++] = c;
   }
 
+  // Number of characters appended so far
+  size_t size() const {
+    return _size;
+  }
+
   char* complete() {
     append('\0');
+    // a short string is padded, see MemoryPool::stringSize()
+    size_t size = _size;
+    while (_slot.value && _size < MemoryPool::stringSize(size)) append('\0');
     if (_slot.value) {
       _parent->freezeString(_slot, _size);
     }
     return _slot.value;
   }
 
+  // Gives the memory back to the pool, when the string is not needed
+  void discard() {
+    if (_slot.value) _parent->freezeString(_slot, 0);
+  }
+
  private:
   MemoryPool* _parent;
   size_t _size;
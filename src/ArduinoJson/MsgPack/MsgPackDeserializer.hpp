@@ -27,6 +27,25 @@ class MsgPackDeserializer {
         _nestingLimit(nestingLimit) {}
 
   DeserializationError parse(VariantData &variant) {
+    return parseVariant(variant);
+  }
+
+  // Returns the number of bytes that parse() would take from the pool, when
+  // TStringStorage is a PoolSizeCounter (see measureDeserializeMsgPack()).
+  // When the input is invalid, the count stops at the error, so that
+  // deserializeMsgPack() reports that error rather than NoMemory.
+  size_t measure() {
+    VariantSizeCounter variant(&_stringStorage);
+    parseVariant(variant);
+    return _stringStorage.size();
+  }
+
+ private:
+  // Prevent VS warning "assignment operator could not be generated"
+  MsgPackDeserializer &operator=(const MsgPackDeserializer &);
+
+  template <typename TVariant>
+  DeserializationError parseVariant(TVariant &variant) {
     uint8_t code;
     if (!readByte(code)) return DeserializationError::IncompleteInput;
 
@@ -130,10 +149,6 @@ class MsgPackDeserializer {
     }
   }
 
- private:
-  // Prevent VS warning "assignment operator could not be generated"
-  MsgPackDeserializer &operator=(const MsgPackDeserializer &);
-
   bool readByte(uint8_t &value) {
     int c = _reader.read();
     if (c < 0) return false;
@@ -141,11 +156,12 @@ class MsgPackDeserializer {
     return true;
   }
 
+  bool readBytes(char *p, size_t n) {
+    return ReaderTraits<TReader>::readBytes(_reader, p, n) == n;
+  }
+
   bool readBytes(uint8_t *p, size_t n) {
-    for (size_t i = 0; i < n; i++) {
-      if (!readByte(p[i])) return false;
-    }
-    return true;
+    return readBytes(reinterpret_cast<char *>(p), n);
   }
 
   template <typename T>
@@ -168,17 +184,17 @@ class MsgPackDeserializer {
     return true;
   }
 
-  template <typename T>
-  DeserializationError readInteger(VariantData &variant) {
+  template <typename T, typename TVariant>
+  DeserializationError readInteger(TVariant &variant) {
     T value;
     if (!readInteger(value)) return DeserializationError::IncompleteInput;
     variant.setInteger(value);
     return DeserializationError::Ok;
   }
 
-  template <typename T>
+  template <typename T, typename TVariant>
   typename enable_if<sizeof(T) == 4, DeserializationError>::type readFloat(
-      VariantData &variant) {
+      TVariant &variant) {
     T value;
     if (!readBytes(value)) return DeserializationError::IncompleteInput;
     fixEndianess(value);
@@ -186,9 +202,9 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
-  template <typename T>
+  template <typename T, typename TVariant>
   typename enable_if<sizeof(T) == 8, DeserializationError>::type readDouble(
-      VariantData &variant) {
+      TVariant &variant) {
     T value;
     if (!readBytes(value)) return DeserializationError::IncompleteInput;
     fixEndianess(value);
@@ -196,9 +212,9 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
-  template <typename T>
+  template <typename T, typename TVariant>
   typename enable_if<sizeof(T) == 4, DeserializationError>::type readDouble(
-      VariantData &variant) {
+      TVariant &variant) {
     uint8_t i[8];  // input is 8 bytes
     T value;       // output is 4 bytes
     uint8_t *o = reinterpret_cast<uint8_t *>(&value);
@@ -209,8 +225,8 @@ class MsgPackDeserializer {
     return DeserializationError::Ok;
   }
 
-  template <typename T>
-  DeserializationError readString(VariantData &variant) {
+  template <typename T, typename TVariant>
+  DeserializationError readString(TVariant &variant) {
     T size;
     if (!readInteger(size)) return DeserializationError::IncompleteInput;
     return readString(variant, size);
@@ -223,72 +239,113 @@ class MsgPackDeserializer {
     return readString(str, size);
   }
 
-  DeserializationError readString(VariantData &variant, size_t n) {
-    const char *s;
-    DeserializationError err = readString(s, n);
-    if (!err) variant.setOwnedString(make_not_null(s));
-    return err;
+  template <typename TVariant>
+  DeserializationError readString(TVariant &variant, size_t n) {
+    StringBuilder builder = _stringStorage.startString();
+    DeserializationError err = readString(builder, n);
+    if (err) return err;
+    if (!saveStringValue(variant, builder, _pool))
+      return DeserializationError::NoMemory;
+    return DeserializationError::Ok;
   }
 
   DeserializationError readString(const char *&result, size_t n) {
     StringBuilder builder = _stringStorage.startString();
-    for (; n; --n) {
-      uint8_t c;
-      if (!readBytes(c)) return DeserializationError::IncompleteInput;
-      builder.append(static_cast<char>(c));
-    }
+    DeserializationError err = readString(builder, n);
+    if (err) return err;
     result = builder.complete();
     if (!result) return DeserializationError::NoMemory;
     return DeserializationError::Ok;
   }
 
-  template <typename TSize>
-  DeserializationError readArray(CollectionData &array) {
+  // Appends n bytes to the builder, straight from the input if the reader
+  // supports peekSpan()
+  DeserializationError readString(StringBuilder &builder, size_t n) {
+    return readString(
+        builder, n,
+        integral_constant<bool, ReaderTraits<TReader>::hasPeekSpan>());
+  }
+
+  DeserializationError readString(StringBuilder &builder, size_t n,
+                                  true_type) {
+    size_t size;
+    const char *s = _reader.peekSpan(size);
+    // an unbounded span is trusted, like readBytes() does
+    if (size < n) return DeserializationError::IncompleteInput;
+    builder.append(s, n);
+    _reader.skip(n);
+    return DeserializationError::Ok;
+  }
+
+  DeserializationError readString(StringBuilder &builder, size_t n,
+                                  false_type) {
+    char buffer[32];
+    while (n) {
+      size_t chunk = n < sizeof(buffer) ? n : sizeof(buffer);
+      if (!readBytes(buffer, chunk))
+        return DeserializationError::IncompleteInput;
+      builder.append(buffer, chunk);
+      n -= chunk;
+    }
+    return DeserializationError::Ok;
+  }
+
+  template <typename TSize, typename TCollection>
+  DeserializationError readArray(TCollection &array) {
     TSize size;
     if (!readInteger(size)) return DeserializationError::IncompleteInput;
     return readArray(array, size);
   }
 
-  DeserializationError readArray(CollectionData &array, size_t n) {
+  template <typename TCollection>
+  DeserializationError readArray(TCollection &array, size_t n) {
     if (_nestingLimit == 0) return DeserializationError::TooDeep;
     --_nestingLimit;
     for (; n; --n) {
-      VariantData *value = array.add(_pool);
-      if (!value) return DeserializationError::NoMemory;
-
-      DeserializationError err = parse(*value);
+      DeserializationError err = readElement(array.add(_pool));
       if (err) return err;
     }
     ++_nestingLimit;
     return DeserializationError::Ok;
   }
 
-  template <typename TSize>
-  DeserializationError readObject(CollectionData &object) {
+  template <typename TVariant>
+  DeserializationError readElement(TVariant *value) {
+    if (!value) return DeserializationError::NoMemory;
+    return parseVariant(*value);
+  }
+
+  template <typename TSize, typename TCollection>
+  DeserializationError readObject(TCollection &object) {
     TSize size;
     if (!readInteger(size)) return DeserializationError::IncompleteInput;
     return readObject(object, size);
   }
 
-  DeserializationError readObject(CollectionData &object, size_t n) {
+  template <typename TCollection>
+  DeserializationError readObject(TCollection &object, size_t n) {
     if (_nestingLimit == 0) return DeserializationError::TooDeep;
     --_nestingLimit;
     for (; n; --n) {
-      VariantSlot *slot = object.addSlot(_pool);
-      if (!slot) return DeserializationError::NoMemory;
-
-      const char *key;
-      DeserializationError err = parseKey(key);
-      if (err) return err;
-      slot->setOwnedKey(make_not_null(key));
-
-      err = parse(*slot->data());
+      DeserializationError err = readMember(object.addSlot(_pool));
       if (err) return err;
     }
     ++_nestingLimit;
     return DeserializationError::Ok;
   }
 
+  template <typename TSlot>
+  DeserializationError readMember(TSlot *slot) {
+    if (!slot) return DeserializationError::NoMemory;
+
+    const char *key;
+    DeserializationError err = parseKey(key);
+    if (err) return err;
+    slot->setOwnedKey(make_not_null(_pool->internKey(key)));
+
+    return parseVariant(*slot->data());
+  }
+
   DeserializationError parseKey(const char *&key) {
     uint8_t code;
     if (!readByte(code)) return DeserializationError::IncompleteInput;
@@ -343,4 +400,31 @@ DeserializationError deserializeMsgPack(
     NestingLimit nestingLimit = NestingLimit()) {
   return deserialize<MsgPackDeserializer>(doc, input, nestingLimit);
 }
+
+// Returns the capacity of the JsonDocument that deserializeMsgPack() needs
+// for this input; reads the input without building anything
+template <typename TInput>
+size_t measureDeserializeMsgPack(const TInput &input,
+                                 NestingLimit nestingLimit = NestingLimit()) {
+  return measureDeserialize<MsgPackDeserializer>(input, nestingLimit);
+}
+
+template <typename TInput>
+size_t measureDeserializeMsgPack(TInput *input,
+                                 NestingLimit nestingLimit = NestingLimit()) {
+  return measureDeserialize<MsgPackDeserializer>(input, nestingLimit);
+}
+
+template <typename TInput>
+size_t measureDeserializeMsgPack(TInput *input, size_t inputSize,
+                                 NestingLimit nestingLimit = NestingLimit()) {
+  return measureDeserialize<MsgPackDeserializer>(input, inputSize,
+                                                 nestingLimit);
+}
+
+template <typename TInput>
+size_t measureDeserializeMsgPack(TInput &input,
+                                 NestingLimit nestingLimit = NestingLimit()) {
+  return measureDeserialize<MsgPackDeserializer>(input, nestingLimit);
+}
 }  // namespace ARDUINOJSON_NAMESPACE
@@ -37,21 +37,19 @@ class MsgPackSerializer {
   }
 
   void visitArray(const CollectionData& array) {
-    size_t n = array.size();
-    if (n < 0x10) {
-      writeByte(uint8_t(0x90 + array.size()));
-    } else if (n < 0x10000) {
-      writeByte(0xDC);
-      writeInteger(uint16_t(n));
-    } else {
-      writeByte(0xDD);
-      writeInteger(uint32_t(n));
-    }
+    writeArrayHeader(array.size());
     for (VariantSlot* slot = array.head(); slot; slot = slot->next()) {
       slot->data()->accept(*this);
     }
   }
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  void visitTypedArray(const TypedArray& array) {
+    writeArrayHeader(array.size());
+    for (size_t i = 0; i < array.size(); i++) array.acceptElement(i, *this);
+  }
+#endif
+
   void visitObject(const CollectionData& object) {
     size_t n = object.size();
     if (n < 0x10) {
@@ -71,9 +69,10 @@ class MsgPackSerializer {
 
   void visitString(const char* value) {
     if (!value) return writeByte(0xC0);  // nil
+    visitString(value, strlen(value));
+  }
 
-    size_t n = strlen(value);
-
+  void visitString(const char* value, size_t n) {
     if (n < 0x20) {
       writeByte(uint8_t(0xA0 + n));
     } else if (n < 0x100) {
@@ -149,6 +148,18 @@ class MsgPackSerializer {
   }
 
  private:
+  void writeArrayHeader(size_t n) {
+    if (n < 0x10) {
+      writeByte(uint8_t(0x90 + n));
+    } else if (n < 0x10000) {
+      writeByte(0xDC);
+      writeInteger(uint16_t(n));
+    } else {
+      writeByte(0xDD);
+      writeInteger(uint32_t(n));
+    }
+  }
+
   void writeByte(uint8_t c) {
     _bytesWritten += _writer->write(c);
   }
@@ -14,15 +14,68 @@
   ARDUINOJSON_CONCAT2(A, ARDUINOJSON_CONCAT2(B, C))
 #define ARDUINOJSON_CONCAT4(A, B, C, D) \
   ARDUINOJSON_CONCAT2(ARDUINOJSON_CONCAT2(A, B), ARDUINOJSON_CONCAT2(C, D))
+#define ARDUINOJSON_CONCAT5(A, B, C, D, E) \
+  ARDUINOJSON_CONCAT2(ARDUINOJSON_CONCAT4(A, B, C, D), E)
 #define ARDUINOJSON_CONCAT8(A, B, C, D, E, F, G, H)    \
   ARDUINOJSON_CONCAT2(ARDUINOJSON_CONCAT4(A, B, C, D), \
                       ARDUINOJSON_CONCAT4(E, F, G, H))
 #define ARDUINOJSON_CONCAT10(A, B, C, D, E, F, G, H, I, J) \
   ARDUINOJSON_CONCAT8(A, B, C, D, E, F, G, ARDUINOJSON_CONCAT3(H, I, J))
+#define ARDUINOJSON_CONCAT11(A, B, C, D, E, F, G, H, I, J, K) \
+  ARDUINOJSON_CONCAT8(A, B, C, D, E, F, G, ARDUINOJSON_CONCAT4(H, I, J, K))
+#define ARDUINOJSON_CONCAT12(A, B, C, D, E, F, G, H, I, J, K, L) \
+  ARDUINOJSON_CONCAT11(A, B, C, D, E, F, G, H, I, J, ARDUINOJSON_CONCAT2(K, L))
+#define ARDUINOJSON_CONCAT13(A, B, C, D, E, F, G, H, I, J, K, L, M) \
+  ARDUINOJSON_CONCAT11(A, B, C, D, E, F, G, H, I, J,                \
+                       ARDUINOJSON_CONCAT3(K, L, M))
+#define ARDUINOJSON_CONCAT14(A, B, C, D, E, F, G, H, I, J, K, L, M, N) \
+  ARDUINOJSON_CONCAT11(A, B, C, D, E, F, G, H, I, J,                   \
+                       ARDUINOJSON_CONCAT4(K, L, M, N))
+#define ARDUINOJSON_CONCAT15(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O) \
+  ARDUINOJSON_CONCAT14(A, B, C, D, E, F, G, H, I, J, K, L, M,             \
+                       ARDUINOJSON_CONCAT2(N, O))
+#define ARDUINOJSON_CONCAT16(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P) \
+  ARDUINOJSON_CONCAT14(A, B, C, D, E, F, G, H, I, J, K, L, M,                \
+                       ARDUINOJSON_CONCAT3(N, O, P))
+#define ARDUINOJSON_CONCAT17(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q)                                              \
+  ARDUINOJSON_CONCAT14(A, B, C, D, E, F, G, H, I, J, K, L, M,                \
+                       ARDUINOJSON_CONCAT4(N, O, P, Q))
+#define ARDUINOJSON_CONCAT18(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R)                                           \
+  ARDUINOJSON_CONCAT17(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P,       \
+                       ARDUINOJSON_CONCAT2(Q, R))
+#define ARDUINOJSON_CONCAT19(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R, S)                                        \
+  ARDUINOJSON_CONCAT17(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P,       \
+                       ARDUINOJSON_CONCAT3(Q, R, S))
 
-#define ARDUINOJSON_NAMESPACE                                            \
-  ARDUINOJSON_CONCAT10(                                                  \
-      ArduinoJson, ARDUINOJSON_VERSION_MAJOR, ARDUINOJSON_VERSION_MINOR, \
-      ARDUINOJSON_VERSION_REVISION, _, ARDUINOJSON_USE_LONG_LONG,        \
-      ARDUINOJSON_USE_DOUBLE, ARDUINOJSON_DECODE_UNICODE,                \
-      ARDUINOJSON_ENABLE_NAN, ARDUINOJSON_ENABLE_INFINITY)
+#define ARDUINOJSON_CONCAT20(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R, S, T)                                     \
+  ARDUINOJSON_CONCAT17(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P,       \
+                       ARDUINOJSON_CONCAT4(Q, R, S, T))
+
+#define ARDUINOJSON_CONCAT21(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R, S, T, U)                                  \
+  ARDUINOJSON_CONCAT17(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P,       \
+                       ARDUINOJSON_CONCAT5(Q, R, S, T, U))
+
+#define ARDUINOJSON_CONCAT24(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, \
+                             Q, R, S, T, U, V, W, X)                         \
+  ARDUINOJSON_CONCAT21(A, B, C, D, E, F, G, H, I, J, K, L, M, N, O, P, Q, R, \
+                       S, T, ARDUINOJSON_CONCAT4(U, V, W, X))
+
+#define ARDUINOJSON_NAMESPACE                                             \
+  ARDUINOJSON_CONCAT24(                                                   \
+      ArduinoJson, ARDUINOJSON_VERSION_MAJOR, ARDUINOJSON_VERSION_MINOR,  \
+      ARDUINOJSON_VERSION_REVISION, _, ARDUINOJSON_USE_LONG_LONG,         \
+      ARDUINOJSON_USE_DOUBLE, ARDUINOJSON_DECODE_UNICODE,                 \
+      ARDUINOJSON_ENABLE_NAN, ARDUINOJSON_ENABLE_INFINITY,                \
+      ARDUINOJSON_ENABLE_GROWABLE_POOL, ARDUINOJSON_ENABLE_FREE_LISTS,    \
+      ARDUINOJSON_STRING_INTERNING, ARDUINOJSON_CACHE_COLLECTION_SIZE,    \
+      ARDUINOJSON_ENABLE_OBJECT_INDEX, ARDUINOJSON_ENABLE_ARRAY_INDEX,    \
+      ARDUINOJSON_ENABLE_KEY_FINGERPRINT,                                 \
+      ARDUINOJSON_ENABLE_INLINE_STRINGS, ARDUINOJSON_ENABLE_TYPED_ARRAYS, \
+      ARDUINOJSON_ENABLE_POOL_STATS, ARDUINOJSON_ENABLE_LINKED_INPUT,     \
+      ARDUINOJSON_ENABLE_SIMD, ARDUINOJSON_SIMD_ISA,                      \
+      ARDUINOJSON_ENABLE_DOCUMENT_POOL)
@@ -27,10 +27,11 @@ class PairPtr {
 
 class ObjectIterator {
  public:
-  ObjectIterator() : _slot(0) {}
+  ObjectIterator() : _slot(0), _previous(0) {}
 
-  explicit ObjectIterator(MemoryPool *pool, VariantSlot *slot)
-      : _pool(pool), _slot(slot) {}
+  explicit ObjectIterator(MemoryPool *pool, VariantSlot *slot,
+                          VariantSlot *previous = 0)
+      : _pool(pool), _slot(slot), _previous(previous) {}
 
   Pair operator*() const {
     return Pair(_pool, _slot);
@@ -48,12 +49,13 @@ class ObjectIterator {
   }
 
   ObjectIterator &operator++() {
+    _previous = _slot;
     _slot = _slot->next();
     return *this;
   }
 
   ObjectIterator &operator+=(size_t distance) {
-    _slot = _slot->next(distance);
+    while (distance-- && _slot) ++*this;
     return *this;
   }
 
@@ -61,9 +63,15 @@ class ObjectIterator {
     return _slot;
   }
 
+  // The slot before internal(), or 0 if it's the first
+  VariantSlot *internalPrevious() {
+    return _previous;
+  }
+
  private:
   MemoryPool *_pool;
   VariantSlot *_slot;
+  VariantSlot *_previous;
 };
 
 class PairConstPtr {
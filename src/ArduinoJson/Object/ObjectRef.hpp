@@ -160,6 +160,7 @@ class ObjectRef : public ObjectRefBase<CollectionData>,
 
   void clear() const {
     if (!_data) return;
+    _data->release(_pool);
     _data->clear();
   }
 
@@ -204,14 +205,25 @@ class ObjectRef : public ObjectRefBase<CollectionData>,
 
   FORCE_INLINE void remove(iterator it) const {
     if (!_data) return;
-    _data->remove(it.internal());
+    _data->remove(it.internal(), _pool);
+  }
+
+  // Removes the member at specified position, and returns the position of
+  // the next one. Unlike remove(iterator), this doesn't search the previous
+  // member, provided that the iterator comes from begin(), operator++ or
+  // erase(), and that nothing was removed since.
+  FORCE_INLINE iterator erase(iterator it) const {
+    if (!_data || !it.internal()) return end();
+    VariantSlot* next = it.internal()->next();
+    _data->remove(it.internal(), it.internalPrevious(), _pool);
+    return iterator(_pool, next, it.internalPrevious());
   }
 
   // remove(const std::string&) const
   // remove(const String&) const
   template <typename TString>
   FORCE_INLINE void remove(const TString& key) const {
-    objectRemove(_data, adaptString(key));
+    objectRemove(_data, adaptString(key), _pool);
   }
 
   // remove(char*) const
@@ -219,13 +231,13 @@ class ObjectRef : public ObjectRefBase<CollectionData>,
   // remove(const __FlashStringHelper*) const
   template <typename TChar>
   FORCE_INLINE void remove(TChar* key) const {
-    objectRemove(_data, adaptString(key));
+    objectRemove(_data, adaptString(key), _pool);
   }
 
  private:
   template <typename TAdaptedString>
   FORCE_INLINE VariantRef get_impl(TAdaptedString key) const {
-    return VariantRef(_pool, objectGet(_data, key));
+    return VariantRef(_pool, objectGet(_data, key, _pool));
   }
 
   template <typename TAdaptedString>
@@ -21,28 +21,28 @@ class VariantComparisons {
   template <typename T>
   friend typename enable_if<IsString<T *>::value, bool>::type operator==(
       T *lhs, TVariant rhs) {
-    return adaptString(lhs).equals(rhs.template as<const char *>());
+    return equals(adaptString(lhs), rhs);
   }
 
   // std::string == TVariant
   template <typename T>
   friend typename enable_if<IsString<T>::value, bool>::type operator==(
       const T &lhs, TVariant rhs) {
-    return adaptString(lhs).equals(rhs.template as<const char *>());
+    return equals(adaptString(lhs), rhs);
   }
 
   // TVariant == const char*
   template <typename T>
   friend typename enable_if<IsString<T *>::value, bool>::type operator==(
       TVariant lhs, T *rhs) {
-    return adaptString(rhs).equals(lhs.template as<const char *>());
+    return equals(adaptString(rhs), lhs);
   }
 
   // TVariant == std::string
   template <typename T>
   friend typename enable_if<IsString<T>::value, bool>::type operator==(
       TVariant lhs, const T &rhs) {
-    return adaptString(rhs).equals(lhs.template as<const char *>());
+    return equals(adaptString(rhs), lhs);
   }
 
   // bool/int/float == TVariant
@@ -63,28 +63,28 @@ class VariantComparisons {
   template <typename T>
   friend typename enable_if<IsString<T *>::value, bool>::type operator!=(
       T *lhs, TVariant rhs) {
-    return !adaptString(lhs).equals(rhs.template as<const char *>());
+    return !equals(adaptString(lhs), rhs);
   }
 
   // std::string != TVariant
   template <typename T>
   friend typename enable_if<IsString<T>::value, bool>::type operator!=(
       const T &lhs, TVariant rhs) {
-    return !adaptString(lhs).equals(rhs.template as<const char *>());
+    return !equals(adaptString(lhs), rhs);
   }
 
   // TVariant != const char*
   template <typename T>
   friend typename enable_if<IsString<T *>::value, bool>::type operator!=(
       TVariant lhs, T *rhs) {
-    return !adaptString(rhs).equals(lhs.template as<const char *>());
+    return !equals(adaptString(rhs), lhs);
   }
 
   // TVariant != std::string
   template <typename T>
   friend typename enable_if<IsString<T>::value, bool>::type operator!=(
       TVariant lhs, const T &rhs) {
-    return !adaptString(rhs).equals(lhs.template as<const char *>());
+    return !equals(adaptString(rhs), lhs);
   }
 
   // bool/int/float != TVariant
@@ -156,6 +156,11 @@ class VariantComparisons {
       TVariant lhs, const T &rhs) {
     return lhs.template as<T>() >= rhs;
   }
+
+ private:
+  // Defined in VariantImpl.hpp, where VariantConstRef is complete
+  template <typename TAdaptedString>
+  static bool equals(TAdaptedString lhs, const TVariant &rhs);
 };
 
 }  // namespace ARDUINOJSON_NAMESPACE
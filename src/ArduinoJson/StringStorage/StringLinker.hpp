@@ -0,0 +1,100 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+
+#include "../Deserialization/CharPointerReader.hpp"
+#include "../Memory/MemoryPool.hpp"
+#include "../Memory/StringBuilder.hpp"
+#include "../Polyfills/type_traits.hpp"
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// Links the string values to an input that outlives the JsonDocument
+// (see ARDUINOJSON_ENABLE_LINKED_INPUT).
+// A string that the deserializer appends in one piece, straight from the
+// input, stays there. As soon as another character comes, the string is
+// copied in the pool, like with StringCopier. The keys are copied too,
+// because they must be C strings.
+class StringLinker {
+ public:
+  class StringBuilder {
+   public:
+    explicit StringBuilder(MemoryPool* pool)
+        : _copy(pool), _linked(""), _size(0) {}
+
+    // The characters may be decoded, so they are copied
+    void append(char c) {
+      unlink();
+      _copy.append(c);
+    }
+
+    // The characters come from the input
+    void append(const char* s, size_t n) {
+      if (_linked && !_size) {
+        _linked = s;
+        _size = n;
+      } else {
+        unlink();
+        _copy.append(s, n);
+      }
+    }
+
+    // Number of characters appended so far
+    size_t size() const {
+      return _linked ? _size : _copy.size();
+    }
+
+    // Returns the string as a C string, in the pool
+    char* complete() {
+      unlink();
+      return _copy.complete();
+    }
+
+    // Returns the string in the input, or 0 if it was copied
+    const char* linked() const {
+      return _linked;
+    }
+
+    // Gives back the memory of the copy, which the linked string didn't need
+    void discard() {
+      _copy.discard();
+    }
+
+   private:
+    void unlink() {
+      if (!_linked) return;
+      _copy.append(_linked, _size);
+      _linked = 0;
+    }
+
+    ARDUINOJSON_NAMESPACE::StringBuilder _copy;
+    const char* _linked;
+    size_t _size;
+  };
+
+  StringLinker(MemoryPool* pool) : _pool(pool) {}
+
+  StringBuilder startString() {
+    return StringBuilder(_pool);
+  }
+
+ private:
+  MemoryPool* _pool;
+};
+
+// Tells if the input is a read-only buffer passed by pointer, which the
+// caller keeps alive; a std::string or a String is often a temporary, so its
+// strings are copied
+template <typename TInput>
+struct IsLinkableInput : false_type {};
+
+template <typename TChar>
+struct IsLinkableInput<const TChar*>
+    : integral_constant<bool, IsCharOrVoid<TChar>::value> {};
+}  // namespace ARDUINOJSON_NAMESPACE
+
+#endif
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <string.h>  // memmove
+
 namespace ARDUINOJSON_NAMESPACE {
 
 class StringMover {
@@ -16,6 +18,18 @@ class StringMover {
       *(*_writePtr)++ = char(c);
     }
 
+    // The characters may come from the same buffer, ahead of the write
+    // pointer
+    void append(const char* s, size_t n) {
+      memmove(*_writePtr, s, n);
+      *_writePtr += n;
+    }
+
+    // Number of characters appended so far
+    size_t size() const {
+      return size_t(*_writePtr - _startPtr);
+    }
+
     char* complete() const {
       *(*_writePtr)++ = 0;
       return _startPtr;
@@ -4,11 +4,20 @@
 
 #pragma once
 
+#include "../Polyfills/gsl/not_null.hpp"
 #include "./StringCopier.hpp"
+#include "./StringLinker.hpp"
 #include "./StringMover.hpp"
 
 namespace ARDUINOJSON_NAMESPACE {
 
+// Chooses where the deserializers store the strings:
+// - StringCopier copies them in the MemoryPool,
+// - StringMover decodes them in the input buffer, which must be writable,
+//   and outlive the JsonDocument,
+// - StringLinker links the values to a read-only input, which must outlive
+//   the JsonDocument, and copies the rest (see
+//   ARDUINOJSON_ENABLE_LINKED_INPUT).
 template <typename TInput, typename Enable = void>
 struct StringStorage {
   typedef StringCopier type;
@@ -28,6 +37,19 @@ struct StringStorage<TChar*,
   }
 };
 
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+// The readers of these inputs append the strings straight from the input
+template <typename TInput>
+struct StringStorage<TInput,
+                     typename enable_if<IsLinkableInput<TInput>::value>::type> {
+  typedef StringLinker type;
+
+  static type create(MemoryPool& pool, TInput&) {
+    return type(&pool);
+  }
+};
+#endif
+
 template <typename TInput>
 typename StringStorage<TInput>::type makeStringStorage(MemoryPool& pool,
                                                        TInput& input) {
@@ -39,4 +61,29 @@ typename StringStorage<TChar*>::type makeStringStorage(MemoryPool& pool,
                                                        TChar* input) {
   return StringStorage<TChar*>::create(pool, input);
 }
+
+// Stores a string value, once the builder has all its characters
+template <typename TVariant, typename TStringBuilder>
+bool saveStringValue(TVariant& variant, TStringBuilder& builder,
+                     MemoryPool* pool) {
+  size_t size = builder.size();
+  const char* value = builder.complete();
+  if (!value) return false;
+  variant.setSavedString(value, size, pool);
+  return true;
+}
+
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+template <typename TVariant>
+bool saveStringValue(TVariant& variant, StringLinker::StringBuilder& builder,
+                     MemoryPool* pool) {
+  const char* linked = builder.linked();
+  if (!linked)
+    return saveStringValue<TVariant, StringLinker::StringBuilder>(
+        variant, builder, pool);
+  builder.discard();
+  variant.setLinkedInput(make_not_null(linked), builder.size());
+  return true;
+}
+#endif
 }  // namespace ARDUINOJSON_NAMESPACE
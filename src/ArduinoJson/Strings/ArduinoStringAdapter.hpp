@@ -32,6 +32,12 @@ class ArduinoStringAdapter {
     return 0 == strcmp(actual, expected);
   }
 
+  // Compares with n characters, which may not be terminated
+  bool equals(const char* expected, size_t n) const {
+    const char* actual = _str->c_str();
+    return actual && _str->length() == n && 0 == memcmp(actual, expected, n);
+  }
+
   const char* data() const {
     return _str->c_str();
   }
@@ -5,7 +5,7 @@
 #pragma once
 
 #include <stddef.h>  // size_t
-#include <string.h>  // strcmp
+#include <string.h>  // memcmp, strcmp
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -19,6 +19,11 @@ class ConstRamStringAdapter {
     return strcmp(actual, expected) == 0;
   }
 
+  // Compares with n characters, which may not be terminated
+  bool equals(const char* expected, size_t n) const {
+    return _str && strlen(_str) == n && memcmp(_str, expected, n) == 0;
+  }
+
   bool isNull() const {
     return !_str;
   }
@@ -16,6 +16,12 @@ class FlashStringAdapter {
     return strcmp_P(expected, actual) == 0;
   }
 
+  // Compares with n characters, which may not be terminated
+  bool equals(const char* expected, size_t n) const {
+    const char* actual = reinterpret_cast<const char*>(_str);
+    return actual && size() == n && memcmp_P(expected, actual, n) == 0;
+  }
+
   bool isNull() const {
     return !_str;
   }
@@ -17,6 +17,12 @@ class SizedFlashStringAdapter {
     return strncmp_P(expected, actual, _size) == 0;
   }
 
+  // Compares with n characters, which may not be terminated
+  bool equals(const char* expected, size_t n) const {
+    const char* actual = reinterpret_cast<const char*>(_str);
+    return actual && _size == n && memcmp_P(expected, actual, n) == 0;
+  }
+
   bool isNull() const {
     return !_str;
   }
@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include <string.h>  // strcmp
+#include <string.h>  // memcmp, strcmp
 
 namespace ARDUINOJSON_NAMESPACE {
 
@@ -18,6 +18,11 @@ class SizedRamStringAdapter {
     return strcmp(actual, expected) == 0;
   }
 
+  // Compares with n characters, which may not be terminated
+  bool equals(const char* expected, size_t n) const {
+    return _str && _size == n && memcmp(_str, expected, n) == 0;
+  }
+
   bool isNull() const {
     return !_str;
   }
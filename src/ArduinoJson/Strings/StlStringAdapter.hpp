@@ -28,6 +28,11 @@ class StlStringAdapter {
     return *_str == expected;
   }
 
+  // Compares with n characters, which may not be terminated
+  bool equals(const char* expected, size_t n) const {
+    return _str->size() == n && _str->compare(0, n, expected, n) == 0;
+  }
+
   const char* data() const {
     return _str->data();
   }
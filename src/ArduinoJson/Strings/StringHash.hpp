@@ -0,0 +1,25 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#pragma once
+
+#include <stddef.h>  // size_t
+#include <stdint.h>  // uint8_t
+
+namespace ARDUINOJSON_NAMESPACE {
+
+// djb2, by Dan Bernstein
+inline size_t hashString(const char* s, size_t n) {
+  size_t h = 5381;
+  while (n--) h = h * 33 + static_cast<unsigned char>(*s++);
+  return h;
+}
+
+// Folds a hash into one byte
+inline uint8_t fingerprintOf(size_t hash) {
+  return static_cast<uint8_t>(hash ^ (hash >> 8) ^ (hash >> 16) ^
+                              (hash >> 24));
+}
+
+}  // namespace ARDUINOJSON_NAMESPACE
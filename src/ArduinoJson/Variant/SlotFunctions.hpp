@@ -19,7 +19,7 @@ inline bool slotSetKey(VariantSlot* var, TAdaptedString key, MemoryPool* pool) {
   } else {
     const char* dup = key.save(pool);
     if (!dup) return false;
-    var->setOwnedKey(make_not_null(dup));
+    var->setOwnedKey(make_not_null(pool->internKey(dup)));
   }
   return true;
 }
@@ -36,4 +36,18 @@ inline size_t slotSize(const VariantSlot* var) {
 inline VariantData* slotData(VariantSlot* slot) {
   return reinterpret_cast<VariantData*>(slot);
 }
+
+// Gives the slot, its key and its value back to the pool
+inline void slotRelease(VariantSlot* slot, MemoryPool* pool) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+  // interned keys are shared
+  if (slot->ownsKey() && ARDUINOJSON_STRING_INTERNING < 1)
+    pool->freeString(slot->key(), strlen(slot->key()) + 1);
+  slot->data()->release(pool);
+  pool->freeVariant(slot);
+#else
+  (void)slot;
+  (void)pool;
+#endif
+}
 }  // namespace ARDUINOJSON_NAMESPACE
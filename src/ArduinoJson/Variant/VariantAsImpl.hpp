@@ -13,6 +13,9 @@ namespace ARDUINOJSON_NAMESPACE {
 template <typename T>
 inline typename enable_if<is_same<ArrayConstRef, T>::value, T>::type variantAs(
     const VariantData* _data) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  if (_data && _data->isTypedArray()) return ArrayConstRef(*_data);
+#endif
   return ArrayConstRef(variantAsArray(_data));
 }
 
@@ -34,6 +37,15 @@ inline typename enable_if<IsWriteableString<T>::value, T>::type variantAs(
   const char* cstr = _data != 0 ? _data->asString() : 0;
   if (cstr) return T(cstr);
   T s;
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+  size_t n;
+  const char* linked = _data != 0 ? _data->asLinkedInput(n) : 0;
+  if (linked) {
+    DynamicStringWriter<T> writer(s);
+    writer.write(reinterpret_cast<const uint8_t*>(linked), n);
+    return s;
+  }
+#endif
   serializeJson(VariantConstRef(_data), s);
   return s;
 }
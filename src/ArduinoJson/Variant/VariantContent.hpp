@@ -25,6 +25,11 @@ enum {
   VALUE_IS_POSITIVE_INTEGER = 0x06,
   VALUE_IS_NEGATIVE_INTEGER = 0x07,
   VALUE_IS_FLOAT = 0x08,
+  VALUE_IS_INLINE_STRING = 0x09,
+  VALUE_IS_LINKED_INPUT = 0x0A,  // a string in the input, not terminated
+
+  TYPED_ARRAY_MASK = 0x78,
+  VALUE_IS_TYPED_ARRAY = 0x10,  // the lower bits hold the TypedArrayType
 
   COLLECTION_MASK = 0x60,
   VALUE_IS_OBJECT = 0x20,
@@ -47,5 +52,6 @@ union VariantContent {
     const char *data;
     size_t size;
   } asRaw;
+  char asInlineString[sizeof(RawData)];  // ARDUINOJSON_ENABLE_INLINE_STRINGS
 };
 }  // namespace ARDUINOJSON_NAMESPACE
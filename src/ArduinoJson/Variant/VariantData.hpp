@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "../Array/TypedArray.hpp"
+#include "../Memory/MemoryPool.hpp"
 #include "../Misc/SerializedValue.hpp"
 #include "../Numbers/convertNumber.hpp"
 #include "../Polyfills/gsl/not_null.hpp"
@@ -24,6 +26,10 @@ class VariantData {
 
   template <typename Visitor>
   void accept(Visitor &visitor) const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (isTypedArray()) return visitor.visitTypedArray(asTypedArray());
+#endif
+
     switch (type()) {
       case VALUE_IS_FLOAT:
         return visitor.visitFloat(_content.asFloat);
@@ -35,9 +41,17 @@ class VariantData {
         return visitor.visitObject(_content.asCollection);
 
       case VALUE_IS_LINKED_STRING:
-      case VALUE_IS_OWNED_STRING:
         return visitor.visitString(_content.asString);
 
+      case VALUE_IS_OWNED_STRING:
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+      case VALUE_IS_LINKED_INPUT:
+#endif
+        return visitor.visitString(_content.asRaw.data, _content.asRaw.size);
+
+      case VALUE_IS_INLINE_STRING:
+        return visitor.visitString(_content.asInlineString);
+
       case VALUE_IS_OWNED_RAW:
       case VALUE_IS_LINKED_RAW:
         return visitor.visitRawJson(_content.asRaw.data, _content.asRaw.size);
@@ -82,14 +96,37 @@ class VariantData {
     return const_cast<VariantData *>(this)->asObject();
   }
 
+  // Same as asArray(), but also converts a typed array to a regular array
+  CollectionData *asArray(MemoryPool *pool) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (isTypedArray() && !expandTypedArray(pool)) return 0;
+#else
+    (void)pool;
+#endif
+    return asArray();
+  }
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  TypedArray asTypedArray() const {
+    ARDUINOJSON_ASSERT(isTypedArray());
+    return TypedArray(_content.asRaw.data, _content.asRaw.size,
+                      uint8_t(_flags & ~TYPED_ARRAY_MASK & VALUE_MASK));
+  }
+#endif
+
   bool copyFrom(const VariantData &src, MemoryPool *pool) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (src.isTypedArray()) return setTypedArray(src.asTypedArray(), pool);
+#endif
+
     switch (src.type()) {
       case VALUE_IS_ARRAY:
         return toArray().copyFrom(src._content.asCollection, pool);
       case VALUE_IS_OBJECT:
         return toObject().copyFrom(src._content.asCollection, pool);
       case VALUE_IS_OWNED_STRING:
-        return setOwnedString(RamStringAdapter(src._content.asString), pool);
+        return setOwnedString(src._content.asRaw.data, src._content.asRaw.size,
+                              pool);
       case VALUE_IS_OWNED_RAW:
         return setOwnedRaw(
             serialized(src._content.asRaw.data, src._content.asRaw.size), pool);
@@ -101,18 +138,35 @@ class VariantData {
   }
 
   bool equals(const VariantData &other) const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (isTypedArray() || other.isTypedArray()) return equalsTypedArray(other);
+#endif
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+    if (type() != other.type() && (type() == VALUE_IS_LINKED_INPUT ||
+                                   other.type() == VALUE_IS_LINKED_INPUT))
+      return equalsLinkedInput(other);
+#endif
     if (type() != other.type()) return false;
 
     switch (type()) {
       case VALUE_IS_LINKED_STRING:
-      case VALUE_IS_OWNED_STRING:
-        return !strcmp(_content.asString, other._content.asString);
+        return _content.asString == other._content.asString ||
+               !strcmp(_content.asString, other._content.asString);
+
+      case VALUE_IS_INLINE_STRING:
+        return !strcmp(_content.asInlineString, other._content.asInlineString);
 
+      case VALUE_IS_OWNED_STRING:
       case VALUE_IS_LINKED_RAW:
       case VALUE_IS_OWNED_RAW:
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+      case VALUE_IS_LINKED_INPUT:
+#endif
+        // interned strings share the same address
         return _content.asRaw.size == other._content.asRaw.size &&
-               !memcmp(_content.asRaw.data, other._content.asRaw.data,
-                       _content.asRaw.size);
+               (_content.asRaw.data == other._content.asRaw.data ||
+                !memcmp(_content.asRaw.data, other._content.asRaw.data,
+                        _content.asRaw.size));
 
       case VALUE_IS_BOOLEAN:
       case VALUE_IS_POSITIVE_INTEGER:
@@ -146,6 +200,12 @@ class VariantData {
     return (_flags & COLLECTION_MASK) != 0;
   }
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  bool isTypedArray() const {
+    return (_flags & TYPED_ARRAY_MASK) == VALUE_IS_TYPED_ARRAY;
+  }
+#endif
+
   template <typename T>
   bool isInteger() const {
     switch (type()) {
@@ -166,7 +226,16 @@ class VariantData {
   }
 
   bool isString() const {
-    return type() == VALUE_IS_LINKED_STRING || type() == VALUE_IS_OWNED_STRING;
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+    if (type() == VALUE_IS_LINKED_INPUT) return true;
+#endif
+    return isCString();
+  }
+
+  // A linked input is a string, but not a C string
+  bool isCString() const {
+    return type() == VALUE_IS_LINKED_STRING ||
+           type() == VALUE_IS_OWNED_STRING || type() == VALUE_IS_INLINE_STRING;
   }
 
   bool isObject() const {
@@ -178,16 +247,74 @@ class VariantData {
   }
 
   bool isEnclosed() const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (isTypedArray()) return true;
+#endif
     return isCollection() || isString();
   }
 
-  void remove(size_t index) {
-    if (isArray()) _content.asCollection.remove(index);
+  // Gives the strings and slots owned by the value back to the pool
+  void release(MemoryPool *pool) {
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (isTypedArray()) {
+      pool->freeString(_content.asRaw.data, asTypedArray().memoryUsage());
+      return;
+    }
+#endif
+    switch (type()) {
+      case VALUE_IS_OWNED_STRING:
+        // interned values are shared
+        if (ARDUINOJSON_STRING_INTERNING < 2)
+          pool->freeString(_content.asRaw.data, _content.asRaw.size + 1);
+        break;
+      case VALUE_IS_OWNED_RAW:
+        pool->freeString(_content.asRaw.data, _content.asRaw.size);
+        break;
+      case VALUE_IS_OBJECT:
+      case VALUE_IS_ARRAY:
+        _content.asCollection.release(pool);
+        break;
+    }
+#else
+    (void)pool;
+#endif
+  }
+
+  // Updates the pointers to the pool, after MemoryPool::squashTo().
+  // The strings outside of the pool stay where they are.
+  void movePointers(const MemoryPoolMove &move) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (isTypedArray()) {
+      _content.asRaw.data = move.relocate(_content.asRaw.data);
+      return;
+    }
+#endif
+    switch (type()) {
+      case VALUE_IS_LINKED_STRING:
+        _content.asString = move.relocate(_content.asString);
+        break;
+      case VALUE_IS_OWNED_STRING:
+      case VALUE_IS_LINKED_RAW:
+      case VALUE_IS_OWNED_RAW:
+      case VALUE_IS_LINKED_INPUT:
+        _content.asRaw.data = move.relocate(_content.asRaw.data);
+        break;
+      case VALUE_IS_OBJECT:
+      case VALUE_IS_ARRAY:
+        _content.asCollection.movePointers(move);
+        break;
+    }
+  }
+
+  void remove(size_t index, MemoryPool *pool) {
+    CollectionData *array = asArray(pool);
+    if (array) array->remove(index, pool);
   }
 
   template <typename TAdaptedString>
-  void remove(TAdaptedString key) {
-    if (isObject()) _content.asCollection.remove(key);
+  void remove(TAdaptedString key, MemoryPool *pool) {
+    if (isObject()) _content.asCollection.remove(key, pool);
   }
 
   void setBoolean(bool value) {
@@ -262,13 +389,47 @@ class VariantData {
     }
   }
 
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+  // Links a string of n characters of the input, which has no terminator
+  // (see ARDUINOJSON_ENABLE_LINKED_INPUT)
+  void setLinkedInput(not_null<const char *> s, size_t n) {
+    setType(VALUE_IS_LINKED_INPUT);
+    _content.asRaw.data = s.get();
+    _content.asRaw.size = n;
+  }
+
+  // Returns the string linked to the input, or 0 if it's another value
+  const char *asLinkedInput(size_t &size) const {
+    if (type() != VALUE_IS_LINKED_INPUT) return 0;
+    size = _content.asRaw.size;
+    return _content.asRaw.data;
+  }
+
+  // Copies the string linked to the input in a C string, for the parsers.
+  // A value that doesn't fit gives an empty string, since no number or
+  // boolean is that long.
+  template <size_t N>
+  const char *copyLinkedInput(char (&buffer)[N]) const {
+    size_t n = _content.asRaw.size < N ? _content.asRaw.size : 0;
+    memcpy(buffer, _content.asRaw.data, n);
+    buffer[n] = 0;
+    return buffer;
+  }
+#endif
+
   void setNull() {
     setType(VALUE_IS_NULL);
   }
 
-  void setOwnedString(not_null<const char *> s) {
+  // The pool holds n characters, plus the terminator
+  void setOwnedString(not_null<const char *> s, size_t n) {
     setType(VALUE_IS_OWNED_STRING);
-    _content.asString = s.get();
+    _content.asRaw.data = s.get();
+    _content.asRaw.size = n;
+  }
+
+  void setOwnedString(not_null<const char *> s) {
+    setOwnedString(s, strlen(s.get()));
   }
 
   bool setOwnedString(const char *s) {
@@ -283,9 +444,73 @@ class VariantData {
 
   template <typename T>
   bool setOwnedString(T value, MemoryPool *pool) {
-    return setOwnedString(value.save(pool));
+    const char *dup = value.save(pool);
+    if (!dup) {
+      setType(VALUE_IS_NULL);
+      return false;
+    }
+    setSavedString(dup, value.size(), pool);
+    return true;
   }
 
+  bool setOwnedString(const char *s, size_t n, MemoryPool *pool) {
+    char *dup = pool->allocFrozenString(n + 1);
+    if (!dup) {
+      setType(VALUE_IS_NULL);
+      return false;
+    }
+    memcpy(dup, s, n + 1);
+    setSavedString(dup, n, pool);
+    return true;
+  }
+
+  // Stores a string of n characters that has just been saved in the pool.
+  // A short string is moved into the slot, and the pool takes it back.
+  void setSavedString(const char *s, size_t n, MemoryPool *pool) {
+#if ARDUINOJSON_ENABLE_INLINE_STRINGS
+    if (n < sizeof(_content.asInlineString) && !memchr(s, 0, n)) {
+      setType(VALUE_IS_INLINE_STRING);
+      memcpy(_content.asInlineString, s, n + 1);
+      pool->releaseString(s, n + 1);
+      return;
+    }
+#endif
+    setOwnedString(make_not_null(pool->internValue(s, n)), n);
+  }
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  // Takes elements that are already in the pool
+  void setTypedArray(const TypedArray &array) {
+    setType(uint8_t(VALUE_IS_TYPED_ARRAY | array.type()));
+    _content.asRaw.data = array.data();
+    _content.asRaw.size = array.size();
+  }
+
+  // Copies the elements in the pool
+  bool setTypedArray(const TypedArray &array, MemoryPool *pool) {
+    size_t n = array.memoryUsage();
+    char *dup = pool->allocFrozenString(n);
+    if (!dup) {
+      setType(VALUE_IS_NULL);
+      return false;
+    }
+    memcpy(dup, array.data(), n);
+    setTypedArray(TypedArray(dup, array.size(), array.type()));
+    return true;
+  }
+
+  // Replaces a typed array with a regular array.
+  // Returns false, and leaves the typed array, if the pool is full.
+  bool expandTypedArray(MemoryPool *pool);
+
+  void setTypedArrayElement(const TypedArray &array, size_t index) {
+    if (array.isFloat())
+      setFloat(array.floatAt(index));
+    else
+      setSignedInteger(array.integerAt(index));
+  }
+#endif
+
   void setUnsignedInteger(UInt value) {
     setType(VALUE_IS_POSITIVE_INTEGER);
     _content.asInteger = static_cast<UInt>(value);
@@ -306,50 +531,76 @@ class VariantData {
   size_t memoryUsage() const {
     switch (type()) {
       case VALUE_IS_OWNED_STRING:
-        return strlen(_content.asString) + 1;
+        return _content.asRaw.size + 1;
       case VALUE_IS_OWNED_RAW:
         return _content.asRaw.size;
       case VALUE_IS_OBJECT:
       case VALUE_IS_ARRAY:
         return _content.asCollection.memoryUsage();
       default:
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+        if (isTypedArray()) return asTypedArray().memoryUsage();
+#endif
         return 0;
     }
   }
 
   size_t nesting() const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (isTypedArray()) return 1;
+#endif
     return isCollection() ? _content.asCollection.nesting() : 0;
   }
 
   size_t size() const {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+    if (isTypedArray()) return _content.asRaw.size;
+#endif
     return isCollection() ? _content.asCollection.size() : 0;
   }
 
   VariantData *addElement(MemoryPool *pool) {
     if (isNull()) toArray();
-    if (!isArray()) return 0;
-    return _content.asCollection.add(pool);
+    CollectionData *array = asArray(pool);
+    return array ? array->add(pool) : 0;
   }
 
   VariantData *getElement(size_t index) const {
     return isArray() ? _content.asCollection.get(index) : 0;
   }
 
+  VariantData *getElement(size_t index, MemoryPool *pool) {
+    CollectionData *array = asArray(pool);
+    return array ? array->get(index, pool) : 0;
+  }
+
   template <typename TAdaptedString>
   VariantData *getMember(TAdaptedString key) const {
     return isObject() ? _content.asCollection.get(key) : 0;
   }
 
+  template <typename TAdaptedString>
+  VariantData *getMember(TAdaptedString key, MemoryPool *pool) {
+    return isObject() ? _content.asCollection.get(key, pool) : 0;
+  }
+
   template <typename TAdaptedString>
   VariantData *getOrAddMember(TAdaptedString key, MemoryPool *pool) {
     if (isNull()) toObject();
     if (!isObject()) return 0;
-    VariantData *var = _content.asCollection.get(key);
+    VariantData *var = _content.asCollection.get(key, pool);
     if (var) return var;
     return _content.asCollection.add(key, pool);
   }
 
  private:
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  bool equalsTypedArray(const VariantData &other) const;
+#endif
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+  bool equalsLinkedInput(const VariantData &other) const;
+#endif
+
   uint8_t type() const {
     return _flags & VALUE_MASK;
   }
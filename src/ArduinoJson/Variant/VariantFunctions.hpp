@@ -31,11 +31,15 @@ inline CollectionData *variantAsObject(VariantData *var) {
 inline bool variantCopyFrom(VariantData *dst, const VariantData *src,
                             MemoryPool *pool) {
   if (!dst) return false;
-  if (!src) {
+  // release the previous value once copied, because src may be part of it
+  VariantData previous = *dst;
+  bool ok = true;
+  if (src)
+    ok = dst->copyFrom(*src, pool);
+  else
     dst->setNull();
-    return true;
-  }
-  return dst->copyFrom(*src, pool);
+  previous.release(pool);
+  return ok;
 }
 
 inline bool variantEquals(const VariantData *a, const VariantData *b) {
@@ -45,6 +49,9 @@ inline bool variantEquals(const VariantData *a, const VariantData *b) {
 }
 
 inline bool variantIsArray(const VariantData *var) {
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  if (var && var->isTypedArray()) return true;
+#endif
   return var && var->isArray();
 }
 
@@ -65,6 +72,11 @@ inline bool variantIsString(const VariantData *var) {
   return var && var->isString();
 }
 
+// Tells if as<const char*>() returns the string
+inline bool variantIsCString(const VariantData *var) {
+  return var && var->isCString();
+}
+
 inline bool variantIsObject(const VariantData *var) {
   return var && var->isObject();
 }
@@ -95,9 +107,25 @@ inline bool variantSetLinkedRaw(VariantData *var,
 template <typename T>
 inline bool variantSetOwnedRaw(VariantData *var, SerializedValue<T> value,
                                MemoryPool *pool) {
-  return var != 0 && var->setOwnedRaw(value, pool);
+  if (!var) return false;
+  // release the previous value once copied, because value may point to it
+  VariantData previous = *var;
+  bool ok = var->setOwnedRaw(value, pool);
+  previous.release(pool);
+  return ok;
 }
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+inline bool variantSetTypedArray(VariantData *var, const TypedArray &value,
+                                 MemoryPool *pool) {
+  if (!var) return false;
+  VariantData previous = *var;
+  bool ok = var->setTypedArray(value, pool);
+  previous.release(pool);
+  return ok;
+}
+#endif
+
 template <typename T>
 inline bool variantSetSignedInteger(VariantData *var, T value) {
   if (!var) return false;
@@ -111,6 +139,11 @@ inline bool variantSetLinkedString(VariantData *var, const char *value) {
   return true;
 }
 
+inline void variantRelease(VariantData *var, MemoryPool *pool) {
+  if (!var) return;
+  var->release(pool);
+}
+
 inline void variantSetNull(VariantData *var) {
   if (!var) return;
   var->setNull();
@@ -124,7 +157,12 @@ inline bool variantSetOwnedString(VariantData *var, char *value) {
 
 template <typename T>
 inline bool variantSetOwnedString(VariantData *var, T value, MemoryPool *pool) {
-  return var != 0 && var->setOwnedString(value, pool);
+  if (!var) return false;
+  // release the previous value once copied, because value may point to it
+  VariantData previous = *var;
+  bool ok = var->setOwnedString(value, pool);
+  previous.release(pool);
+  return ok;
 }
 
 inline bool variantSetUnsignedInteger(VariantData *var, UInt value) {
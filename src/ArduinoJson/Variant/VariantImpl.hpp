@@ -25,6 +25,14 @@ inline T VariantData::asIntegral() const {
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
       return parseInteger<T>(_content.asString);
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+    case VALUE_IS_LINKED_INPUT: {
+      char buffer[64];
+      return parseInteger<T>(copyLinkedInput(buffer));
+    }
+#endif
+    case VALUE_IS_INLINE_STRING:
+      return parseInteger<T>(_content.asInlineString);
     case VALUE_IS_FLOAT:
       return convertFloat<T>(_content.asFloat);
     default:
@@ -43,6 +51,13 @@ inline bool VariantData::asBoolean() const {
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
       return strcmp("true", _content.asString) == 0;
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+    case VALUE_IS_LINKED_INPUT:
+      return _content.asRaw.size == 4 &&
+             memcmp("true", _content.asRaw.data, 4) == 0;
+#endif
+    case VALUE_IS_INLINE_STRING:
+      return strcmp("true", _content.asInlineString) == 0;
     default:
       return false;
   }
@@ -60,6 +75,14 @@ inline T VariantData::asFloat() const {
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
       return parseFloat<T>(_content.asString);
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+    case VALUE_IS_LINKED_INPUT: {
+      char buffer[64];
+      return parseFloat<T>(copyLinkedInput(buffer));
+    }
+#endif
+    case VALUE_IS_INLINE_STRING:
+      return parseFloat<T>(_content.asInlineString);
     case VALUE_IS_FLOAT:
       return static_cast<T>(_content.asFloat);
     default:
@@ -72,11 +95,97 @@ inline const char *VariantData::asString() const {
     case VALUE_IS_LINKED_STRING:
     case VALUE_IS_OWNED_STRING:
       return _content.asString;
+    case VALUE_IS_INLINE_STRING:
+      return _content.asInlineString;
     default:
       return 0;
   }
 }
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+inline bool VariantData::expandTypedArray(MemoryPool *pool) {
+  TypedArray array = asTypedArray();
+  size_t slotZoneSize = pool->slotZoneSize();
+  CollectionData &elements = toArray();
+  for (size_t i = 0; i < array.size(); i++) {
+    VariantData *element = elements.add(pool);
+    if (!element) {
+      // give back the slots added so far
+#if ARDUINOJSON_ENABLE_FREE_LISTS
+      elements.release(pool);
+#else
+      pool->rewindSlotZone(slotZoneSize);
+#endif
+      setTypedArray(array);
+      return false;
+    }
+    element->setTypedArrayElement(array, i);
+  }
+  pool->releaseString(array.data(), array.memoryUsage());
+  return true;
+}
+
+// The other side may be a typed array of another type, or a regular array
+inline bool VariantData::equalsTypedArray(const VariantData &other) const {
+  const VariantData &typed = isTypedArray() ? *this : other;
+  const VariantData &rhs = isTypedArray() ? other : *this;
+  TypedArray array = typed.asTypedArray();
+
+  if (rhs.isTypedArray()) {
+    TypedArray rhsArray = rhs.asTypedArray();
+    if (rhsArray.size() != array.size()) return false;
+    if (rhsArray.type() == array.type())
+      return !memcmp(rhsArray.data(), array.data(), array.memoryUsage());
+  } else if (!rhs.isArray() || rhs.size() != array.size()) {
+    return false;
+  }
+
+  const VariantSlot *slot =
+      rhs.isArray() ? rhs._content.asCollection.head() : 0;
+  for (size_t i = 0; i < array.size(); i++) {
+    VariantData element, rhsElement;
+    element._flags = 0;
+    element.setTypedArrayElement(array, i);
+    if (slot) {
+      if (!element.equals(*slot->data())) return false;
+      slot = slot->next();
+    } else {
+      rhsElement._flags = 0;
+      rhsElement.setTypedArrayElement(rhs.asTypedArray(), i);
+      if (!element.equals(rhsElement)) return false;
+    }
+  }
+  return true;
+}
+#endif
+
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+// A linked input equals the same string stored in any other way
+inline bool VariantData::equalsLinkedInput(const VariantData &other) const {
+  const VariantData &linked = type() == VALUE_IS_LINKED_INPUT ? *this : other;
+  const VariantData &rhs = type() == VALUE_IS_LINKED_INPUT ? other : *this;
+  const char *s = rhs.asString();
+  if (!s) return false;
+  size_t n = strlen(s);
+  return n == linked._content.asRaw.size &&
+         !memcmp(s, linked._content.asRaw.data, n);
+}
+#endif
+
+template <typename TVariant>
+template <typename TAdaptedString>
+inline bool VariantComparisons<TVariant>::equals(TAdaptedString lhs,
+                                                 const TVariant &rhs) {
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+  // a string linked to the input has no terminator
+  VariantConstRef variant = rhs.template as<VariantConstRef>();
+  size_t n;
+  const char *linked = variant._data ? variant._data->asLinkedInput(n) : 0;
+  if (linked) return lhs.equals(linked, n);
+#endif
+  return lhs.equals(rhs.template as<const char *>());
+}
+
 template <typename TVariant>
 typename enable_if<IsVisitable<TVariant>::value, bool>::type VariantRef::set(
     const TVariant &value) const {
@@ -87,7 +196,7 @@ typename enable_if<IsVisitable<TVariant>::value, bool>::type VariantRef::set(
 template <typename T>
 inline typename enable_if<is_same<T, ArrayRef>::value, T>::type VariantRef::as()
     const {
-  return ArrayRef(_pool, _data != 0 ? _data->asArray() : 0);
+  return ArrayRef(_pool, _data != 0 ? _data->asArray(_pool) : 0);
 }
 
 template <typename T>
@@ -99,24 +208,27 @@ VariantRef::as() const {
 template <typename T>
 inline typename enable_if<is_same<T, ArrayRef>::value, ArrayRef>::type
 VariantRef::to() const {
+  variantRelease(_data, _pool);
   return ArrayRef(_pool, variantToArray(_data));
 }
 
 template <typename T>
 typename enable_if<is_same<T, ObjectRef>::value, ObjectRef>::type
 VariantRef::to() const {
+  variantRelease(_data, _pool);
   return ObjectRef(_pool, variantToObject(_data));
 }
 
 template <typename T>
 typename enable_if<is_same<T, VariantRef>::value, VariantRef>::type
 VariantRef::to() const {
+  variantRelease(_data, _pool);
   variantSetNull(_data);
   return *this;
 }
 
 inline VariantConstRef VariantConstRef::operator[](size_t index) const {
-  return ArrayConstRef(_data != 0 ? _data->asArray() : 0)[index];
+  return variantAs<ArrayConstRef>(_data)[index];
 }
 
 inline VariantRef VariantRef::addElement() const {
@@ -124,18 +236,20 @@ inline VariantRef VariantRef::addElement() const {
 }
 
 inline VariantRef VariantRef::getElement(size_t index) const {
-  return VariantRef(_pool, _data != 0 ? _data->getElement(index) : 0);
+  return VariantRef(_pool, _data != 0 ? _data->getElement(index, _pool) : 0);
 }
 
 template <typename TChar>
 inline VariantRef VariantRef::getMember(TChar *key) const {
-  return VariantRef(_pool, _data != 0 ? _data->getMember(adaptString(key)) : 0);
+  return VariantRef(_pool,
+                    _data != 0 ? _data->getMember(adaptString(key), _pool) : 0);
 }
 
 template <typename TString>
 inline typename enable_if<IsString<TString>::value, VariantRef>::type
 VariantRef::getMember(const TString &key) const {
-  return VariantRef(_pool, _data != 0 ? _data->getMember(adaptString(key)) : 0);
+  return VariantRef(_pool,
+                    _data != 0 ? _data->getMember(adaptString(key), _pool) : 0);
 }
 
 template <typename TChar>
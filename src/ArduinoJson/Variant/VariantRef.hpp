@@ -63,14 +63,19 @@ class VariantRefBase {
   //
   // bool is<const char*>() const;
   // bool is<char*>() const;
-  // bool is<std::string>() const;
-  // bool is<String>() const;
   template <typename T>
   FORCE_INLINE typename enable_if<is_same<T, const char *>::value ||
-                                      is_same<T, char *>::value ||
-                                      IsWriteableString<T>::value,
+                                      is_same<T, char *>::value,
                                   bool>::type
   is() const {
+    return variantIsCString(_data);
+  }
+  //
+  // bool is<std::string>() const;
+  // bool is<String>() const;
+  template <typename T>
+  FORCE_INLINE typename enable_if<IsWriteableString<T>::value, bool>::type is()
+      const {
     return variantIsString(_data);
   }
   //
@@ -139,11 +144,13 @@ class VariantRef : public VariantRefBase<VariantData>,
   FORCE_INLINE VariantRef() : base_type(0), _pool(0) {}
 
   FORCE_INLINE void clear() const {
+    variantRelease(_data, _pool);
     return variantSetNull(_data);
   }
 
   // set(bool value)
   FORCE_INLINE bool set(bool value) const {
+    variantRelease(_data, _pool);
     return variantSetBoolean(_data, value);
   }
 
@@ -153,6 +160,7 @@ class VariantRef : public VariantRefBase<VariantData>,
   FORCE_INLINE bool set(
       T value,
       typename enable_if<is_floating_point<T>::value>::type * = 0) const {
+    variantRelease(_data, _pool);
     return variantSetFloat(_data, static_cast<Float>(value));
   }
 
@@ -166,6 +174,7 @@ class VariantRef : public VariantRefBase<VariantData>,
       T value,
       typename enable_if<is_integral<T>::value && is_signed<T>::value>::type * =
           0) const {
+    variantRelease(_data, _pool);
     return variantSetSignedInteger(_data, value);
   }
 
@@ -176,11 +185,13 @@ class VariantRef : public VariantRefBase<VariantData>,
   FORCE_INLINE bool set(
       T value, typename enable_if<is_integral<T>::value &&
                                   is_unsigned<T>::value>::type * = 0) const {
+    variantRelease(_data, _pool);
     return variantSetUnsignedInteger(_data, static_cast<UInt>(value));
   }
 
   // set(SerializedValue<const char *>)
   FORCE_INLINE bool set(SerializedValue<const char *> value) const {
+    variantRelease(_data, _pool);
     return variantSetLinkedRaw(_data, value);
   }
 
@@ -194,6 +205,14 @@ class VariantRef : public VariantRefBase<VariantData>,
     return variantSetOwnedRaw(_data, value, _pool);
   }
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  // set(TypedArray)
+  // (the elements are copied, see copyArray())
+  FORCE_INLINE bool set(const TypedArray &value) const {
+    return variantSetTypedArray(_data, value, _pool);
+  }
+#endif
+
   // set(const std::string&)
   // set(const String&)
   template <typename T>
@@ -213,6 +232,7 @@ class VariantRef : public VariantRefBase<VariantData>,
 
   // set(const char*);
   FORCE_INLINE bool set(const char *value) const {
+    variantRelease(_data, _pool);
     return variantSetLinkedString(_data, value);
   }
 
@@ -313,7 +333,7 @@ class VariantRef : public VariantRefBase<VariantData>,
   FORCE_INLINE VariantRef getOrAddMember(const TString &) const;
 
   FORCE_INLINE void remove(size_t index) const {
-    if (_data) _data->remove(index);
+    if (_data) _data->remove(index, _pool);
   }
   // remove(char*) const
   // remove(const char*) const
@@ -321,14 +341,14 @@ class VariantRef : public VariantRefBase<VariantData>,
   template <typename TChar>
   FORCE_INLINE typename enable_if<IsString<TChar *>::value>::type remove(
       TChar *key) const {
-    if (_data) _data->remove(adaptString(key));
+    if (_data) _data->remove(adaptString(key), _pool);
   }
   // remove(const std::string&) const
   // remove(const String&) const
   template <typename TString>
   FORCE_INLINE typename enable_if<IsString<TString>::value>::type remove(
       const TString &key) const {
-    if (_data) _data->remove(adaptString(key));
+    if (_data) _data->remove(adaptString(key), _pool);
   }
 
  private:
@@ -340,12 +360,36 @@ class VariantConstRef : public VariantRefBase<const VariantData>,
                         public Visitable {
   typedef VariantRefBase<const VariantData> base_type;
   friend class VariantRef;
+#if ARDUINOJSON_ENABLE_LINKED_INPUT
+  template <typename>
+  friend class VariantComparisons;
+#endif
 
  public:
   VariantConstRef() : base_type(0) {}
   VariantConstRef(const VariantData *data) : base_type(data) {}
   VariantConstRef(VariantRef var) : base_type(var._data) {}
 
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+  // An element of a typed array, which has no VariantData in the pool, so the
+  // reference holds a copy of the value
+  VariantConstRef(const TypedArray &array, size_t index)
+      : base_type(&_element) {
+    _element = VariantData();
+    _element.setTypedArrayElement(array, index);
+  }
+
+  VariantConstRef(const VariantConstRef &src) : base_type(src._data) {
+    if (src._data == &src._element) copyElement(src);
+  }
+
+  VariantConstRef &operator=(const VariantConstRef &src) {
+    _data = src._data;
+    if (src._data == &src._element) copyElement(src);
+    return *this;
+  }
+#endif
+
   template <typename Visitor>
   void accept(Visitor &visitor) const {
     variantAccept(_data, visitor);
@@ -379,5 +423,15 @@ class VariantConstRef : public VariantRefBase<const VariantData>,
     const CollectionData *obj = variantAsObject(_data);
     return VariantConstRef(obj ? obj->get(adaptString(key)) : 0);
   }
+
+#if ARDUINOJSON_ENABLE_TYPED_ARRAYS
+ private:
+  void copyElement(const VariantConstRef &src) {
+    _element = src._element;
+    _data = &_element;
+  }
+
+  VariantData _element;
+#endif
 };
 }  // namespace ARDUINOJSON_NAMESPACE
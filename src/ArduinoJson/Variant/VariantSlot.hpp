@@ -4,15 +4,29 @@
 
 #pragma once
 
+#include "../Memory/MemoryPoolMove.hpp"
 #include "../Polyfills/gsl/not_null.hpp"
 #include "../Polyfills/type_traits.hpp"
+#include "../Strings/StringHash.hpp"
 #include "../Variant/VariantContent.hpp"
 
-#include <stdint.h>  // int8_t, int16_t
+#include <stddef.h>  // ptrdiff_t
+#include <stdint.h>  // int8_t, int16_t, int32_t
+#include <string.h>  // strlen
 
 namespace ARDUINOJSON_NAMESPACE {
 
-typedef conditional<sizeof(void*) <= 2, int8_t, int16_t>::type VariantSlotDiff;
+#if ARDUINOJSON_ENABLE_GROWABLE_POOL
+// slots can be in different blocks
+typedef ptrdiff_t VariantSlotDiff;
+#else
+// on 64-bit, a 32-bit offset takes the padding before _key, so the slot size
+// doesn't change, and a collection can span more than 32767 slots
+typedef conditional<
+    sizeof(void*) <= 2, int8_t,
+    conditional<sizeof(void*) >= 8, int32_t, int16_t>::type>::type
+    VariantSlotDiff;
+#endif
 
 class VariantSlot {
   // CAUTION: same layout as VariantData
@@ -20,6 +34,9 @@ class VariantSlot {
   // (+20% on ESP8266 for example)
   VariantContent _content;
   uint8_t _flags;
+#if ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+  uint8_t _fingerprint;  // see KeyMatcher
+#endif
   VariantSlotDiff _next;
   const char* _key;
 
@@ -70,12 +87,12 @@ class VariantSlot {
 
   void setOwnedKey(not_null<const char*> k) {
     _flags |= KEY_IS_OWNED;
-    _key = k.get();
+    setKey(k.get());
   }
 
   void setLinkedKey(not_null<const char*> k) {
     _flags &= VALUE_MASK;
-    _key = k.get();
+    setKey(k.get());
   }
 
   const char* key() const {
@@ -86,10 +103,32 @@ class VariantSlot {
     return (_flags & KEY_IS_OWNED) != 0;
   }
 
+  // The fingerprint stays, since the key is the same
+  void relocateKey(const MemoryPoolMove& move) {
+    _key = move.relocate(_key);
+  }
+
+#if ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+  uint8_t fingerprint() const {
+    return _fingerprint;
+  }
+#endif
+
   void clear() {
     _next = 0;
     _flags = 0;
     _key = 0;
+#if ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+    _fingerprint = 0;
+#endif
+  }
+
+ private:
+  void setKey(const char* k) {
+    _key = k;
+#if ARDUINOJSON_ENABLE_KEY_FINGERPRINT
+    _fingerprint = fingerprintOf(hashString(k, strlen(k)));
+#endif
   }
 };
 
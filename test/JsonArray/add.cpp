@@ -136,3 +136,20 @@ TEST_CASE("JsonArray::add()") {
     REQUIRE(expectedSize == doc.memoryUsage());
   }
 }
+
+TEST_CASE("JsonArray::add() far from the previous element") {
+  // the slots of b separate the two elements of a
+  const size_t n = sizeof(void*) >= 8 ? 40000 : 1000;
+  DynamicJsonDocument doc(JSON_ARRAY_SIZE(n + 3) + JSON_OBJECT_SIZE(2));
+  JsonArray a = doc.createNestedArray("a");
+  JsonArray b = doc.createNestedArray("b");
+
+  a.add(1);
+  for (size_t i = 0; i < n; i++) b.add(0);
+  a.add(2);
+
+  REQUIRE(a.size() == 2);
+  REQUIRE(a[0] == 1);
+  REQUIRE(a[1] == 2);
+  REQUIRE(b.size() == n);
+}
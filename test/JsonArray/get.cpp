@@ -14,3 +14,12 @@ TEST_CASE("JsonArray::get()") {
     REQUIRE(array.getElement(3).isNull());
   }
 }
+
+TEST_CASE("JsonArray::get() on an empty array") {
+  DynamicJsonDocument doc(4096);
+  JsonArray array = doc.to<JsonArray>();
+
+  SECTION("Overflow") {
+    REQUIRE(array.getElement(1).isNull());
+  }
+}
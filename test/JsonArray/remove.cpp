@@ -4,6 +4,7 @@
 
 #include <ArduinoJson.h>
 #include <catch.hpp>
+#include <string>
 
 TEST_CASE("JsonArray::remove()") {
   DynamicJsonDocument doc(4096);
@@ -65,4 +66,50 @@ TEST_CASE("JsonArray::remove()") {
     REQUIRE(_array[0] == 1);
     REQUIRE(_array[1] == 2);
   }
+
+  SECTION("erase() the first element") {
+    JsonArray::iterator it = _array.erase(_array.begin());
+
+    REQUIRE(2 == _array.size());
+    REQUIRE(_array[0] == 2);
+    REQUIRE(*it == 2);
+  }
+
+  SECTION("erase() the last element") {
+    JsonArray::iterator it = _array.begin();
+    it += 2;
+    it = _array.erase(it);
+
+    REQUIRE(it == _array.end());
+    REQUIRE(2 == _array.size());
+    _array.add(4);
+    REQUIRE(_array[2] == 4);
+  }
+
+  SECTION("erase() while iterating") {
+    _array.add(4);
+    _array.add(5);
+    JsonArray::iterator it = _array.begin();
+    while (it != _array.end()) {
+      if (it->as<int>() % 2 == 1)
+        it = _array.erase(it);
+      else
+        ++it;
+    }
+
+    std::string json;
+    serializeJson(_array, json);
+    REQUIRE(json == "[2,4]");
+    _array.add(6);
+    REQUIRE(_array[2] == 6);
+  }
+
+  SECTION("erase() all elements") {
+    JsonArray::iterator it = _array.begin();
+    while (it != _array.end()) it = _array.erase(it);
+
+    REQUIRE(0 == _array.size());
+    _array.add(4);
+    REQUIRE(_array[0] == 4);
+  }
 }
@@ -33,6 +33,57 @@ TEST_CASE("deserializeJson(const std::string&)") {
     REQUIRE(err == DeserializationError::Ok);
     REQUIRE(std::string("hello") == array[0]);
   }
+
+  SECTION("should unescape between the plain characters") {
+    std::string input("[\"ab\\ncd\\\"ef\"]");
+
+    DeserializationError err = deserializeJson(doc, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(std::string("ab\ncd\"ef") == doc[0]);
+  }
+
+  SECTION("should detect an unterminated string") {
+    DeserializationError err = deserializeJson(doc, std::string("[\"hello"));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+
+  SECTION("should skip long indentations") {
+    std::string indent(40, ' ');
+    std::string input("{\n" + indent + "\"a\":\t[\r\n" + indent + "1,\n" +
+                      indent + "2\n" + indent + "]\n}" + indent);
+
+    DeserializationError err = deserializeJson(doc, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc["a"][1] == 2);
+  }
+
+  SECTION("should detect input that ends with spaces") {
+    DeserializationError err =
+        deserializeJson(doc, std::string("[1,") + std::string(40, ' '));
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
+}
+
+TEST_CASE("deserializeJson(char*, size_t) with a writable buffer") {
+  DynamicJsonDocument doc(4096);
+  std::string input("{\"hello\":\"wor\\\"ld\"}");
+
+  DeserializationError err = deserializeJson(doc, &input[0], input.size());
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc["hello"] == std::string("wor\"ld"));
+
+  SECTION("strings are decoded in the buffer, instead of the pool") {
+    const char* value = doc["hello"];
+
+    REQUIRE(input.data() <= value);
+    REQUIRE(value < input.data() + input.size());
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+  }
 }
 
 TEST_CASE("deserializeJson(std::istream&)") {
@@ -92,6 +143,16 @@ TEST_CASE("deserializeJson(std::istream&)") {
     REQUIRE('1' == char(json.get()));
   }
 
+  SECTION("Should not read after the closing quote of a long string") {
+    std::string value(100, 'x');
+    std::istringstream json("\"" + value + "\"123");
+
+    deserializeJson(doc, json);
+
+    REQUIRE(doc.as<std::string>() == value);
+    REQUIRE('1' == char(json.get()));
+  }
+
   SECTION("Should not read after the closing quote") {
     std::istringstream json("\"hello\"123");
 
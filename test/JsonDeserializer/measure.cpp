@@ -0,0 +1,99 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+#include <sstream>
+
+static void checkMeasure(const char* json, size_t expected) {
+  size_t capacity = measureDeserializeJson(json);
+  REQUIRE(capacity == expected);
+
+  DynamicJsonDocument doc(capacity);
+  REQUIRE(deserializeJson(doc, json) == DeserializationError::Ok);
+  REQUIRE(doc.memoryUsage() == capacity);
+}
+
+TEST_CASE("measureDeserializeJson()") {
+  SECTION("integer") {
+    checkMeasure("42", 0);
+  }
+
+  SECTION("string") {
+    checkMeasure("\"hello\"", JSON_STRING_SIZE(6));
+  }
+
+  SECTION("escaped string") {
+    checkMeasure("\"a\\tb\\\"c\"", JSON_STRING_SIZE(6));
+  }
+
+  SECTION("empty array") {
+    checkMeasure("[]", 0);
+  }
+
+  SECTION("array") {
+    checkMeasure("[1,\"hi\",true,null]",
+                 JSON_ARRAY_SIZE(4) + JSON_STRING_SIZE(3));
+  }
+
+  SECTION("object") {
+    checkMeasure("{'a':1,b:[2,3]}", JSON_OBJECT_SIZE(2) +
+                                        2 * JSON_STRING_SIZE(2) +
+                                        JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("nested with comments and spaces") {
+    checkMeasure(" { \"values\" : [ {}, [ ] ] /* comment */ } ",
+                 JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(7) +
+                     JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("a smaller document fails") {
+    const char* json = "{\"hello\":\"world\",\"list\":[1,2,3]}";
+    size_t capacity = measureDeserializeJson(json);
+    DynamicJsonDocument doc(capacity - 1);
+
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::NoMemory);
+  }
+
+  SECTION("input is not modified") {
+    char json[] = "[\"hello\"]";
+
+    REQUIRE(measureDeserializeJson(json) == JSON_ARRAY_SIZE(1));
+    REQUIRE(std::string(json) == "[\"hello\"]");
+  }
+
+  SECTION("const char* with size") {
+    REQUIRE(measureDeserializeJson("[1,2]xxx", 5) == JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("std::string") {
+    REQUIRE(measureDeserializeJson(std::string("[\"hi\"]")) ==
+            JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(3));
+  }
+
+  SECTION("std::istream") {
+    std::istringstream json("{\"a\":\"b\"}");
+
+    REQUIRE(measureDeserializeJson(json) ==
+            JSON_OBJECT_SIZE(1) + 2 * JSON_STRING_SIZE(2));
+  }
+
+  SECTION("stops at the nesting limit") {
+    REQUIRE(measureDeserializeJson("[[1]]", DeserializationOption::NestingLimit(
+                                                1)) == JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("stops at the end of the input") {
+    REQUIRE(measureDeserializeJson("[1,[2") ==
+            JSON_ARRAY_SIZE(2) + JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("deserializeJson() reports the error") {
+    const char* json = "[\"hello\",{\"a\":]";
+    DynamicJsonDocument doc(measureDeserializeJson(json));
+
+    REQUIRE(deserializeJson(doc, json) == DeserializationError::InvalidInput);
+  }
+}
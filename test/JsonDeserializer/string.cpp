@@ -70,3 +70,28 @@ TEST_CASE("Not enough room to duplicate the string") {
           DeserializationError::NoMemory);
   REQUIRE(doc.isNull() == true);
 }
+
+TEST_CASE("JSON string with an embedded NUL") {
+  DynamicJsonDocument doc(4096);
+
+  REQUIRE(deserializeJson(doc, "\"a\\u0000b\"") == DeserializationError::Ok);
+
+  SECTION("serializeJson()") {
+    std::string json;
+    serializeJson(doc, json);
+    REQUIRE(json == "\"a\\u0000b\"");
+  }
+
+  SECTION("memoryUsage()") {
+    REQUIRE(doc.memoryUsage() == JSON_STRING_SIZE(4));
+  }
+
+  SECTION("compare") {
+    DynamicJsonDocument doc2(4096);
+    deserializeJson(doc2, "\"a\\u0000c\"");
+    REQUIRE(doc.as<JsonVariant>() != doc2.as<JsonVariant>());
+
+    deserializeJson(doc2, "\"a\\u0000b\"");
+    REQUIRE(doc.as<JsonVariant>() == doc2.as<JsonVariant>());
+  }
+}
@@ -6,29 +6,44 @@
 #include <stdlib.h>  // malloc, free
 #include <catch.hpp>
 #include <sstream>
+#include <utility>  // std::move
 
 using ARDUINOJSON_NAMESPACE::addPadding;
 
 class SpyingAllocator {
  public:
-  SpyingAllocator(std::ostream& log) : _log(log) {}
+  SpyingAllocator(std::ostream& log) : _log(&log) {}
 
   void* allocate(size_t n) {
-    _log << "A" << n;
+    *_log << "A" << n;
     return malloc(n);
   }
   void deallocate(void* p) {
-    _log << "F";
+    *_log << "F";
     free(p);
   }
 
+ protected:
+  std::ostream& log() {
+    return *_log;
+  }
+
  private:
-  SpyingAllocator& operator=(const SpyingAllocator& src);
+  std::ostream* _log;
+};
 
-  std::ostream& _log;
+class ReallocatingAllocator : public SpyingAllocator {
+ public:
+  ReallocatingAllocator(std::ostream& log) : SpyingAllocator(log) {}
+
+  void* reallocate(void* p, size_t n) {
+    log() << "R" << n;
+    return realloc(p, n);
+  }
 };
 
 typedef BasicJsonDocument<SpyingAllocator> MyJsonDocument;
+typedef BasicJsonDocument<ReallocatingAllocator> MyReallocatingJsonDocument;
 
 TEST_CASE("BasicJsonDocument") {
   std::stringstream log;
@@ -46,4 +61,106 @@ TEST_CASE("BasicJsonDocument") {
     }
     REQUIRE(log.str() == "A4096A32FF");
   }
+
+  SECTION("Copy assign to a smaller document") {
+    {
+      MyJsonDocument doc1(4096, log);
+      doc1.set(std::string("The size of this string is 32!!"));
+      MyJsonDocument doc2(8, log);
+      doc2 = doc1;
+
+      REQUIRE(doc2.as<std::string>() == "The size of this string is 32!!");
+      REQUIRE(doc2.capacity() == 32);
+    }
+    REQUIRE(log.str() == "A4096A8FA32FF");
+  }
+
+  SECTION("Copy assign to a smaller document, with reallocate()") {
+    {
+      MyReallocatingJsonDocument doc1(4096, log);
+      doc1.set(std::string("The size of this string is 32!!"));
+      MyReallocatingJsonDocument doc2(8, log);
+      doc2 = doc1;
+
+      REQUIRE(doc2.as<std::string>() == "The size of this string is 32!!");
+      REQUIRE(doc2.capacity() == 32);
+    }
+    REQUIRE(log.str() == "A4096A8R32FF");
+  }
+
+  SECTION("Copy assign to a bigger document, with reallocate()") {
+    {
+      MyReallocatingJsonDocument doc1(4096, log);
+      doc1.set(std::string("The size of this string is 32!!"));
+      MyReallocatingJsonDocument doc2(64, log);
+      doc2 = doc1;
+
+      REQUIRE(doc2.as<std::string>() == "The size of this string is 32!!");
+      REQUIRE(doc2.capacity() == 64);
+    }
+    REQUIRE(log.str() == "A4096A64FF");
+  }
+
+  SECTION("shrinkToFit()") {
+    size_t capa = JSON_OBJECT_SIZE(1) + addPadding(JSON_STRING_SIZE(5));
+    {
+      MyJsonDocument doc(4096, log);
+      doc["hello"] = std::string("world");
+
+      REQUIRE(doc.shrinkToFit() == true);
+
+      REQUIRE(doc.capacity() == capa);
+      REQUIRE(doc["hello"] == "world");
+    }
+    std::stringstream expected;
+    expected << "A4096A" << capa << "FF";
+    REQUIRE(log.str() == expected.str());
+  }
+
+  SECTION("shrinkToFit(), with reallocate()") {
+    size_t capa = JSON_OBJECT_SIZE(1) + addPadding(JSON_STRING_SIZE(5));
+    {
+      MyReallocatingJsonDocument doc(4096, log);
+      doc["hello"] = std::string("world");
+
+      REQUIRE(doc.shrinkToFit() == true);
+
+      REQUIRE(doc.capacity() == capa);
+      REQUIRE(doc["hello"] == "world");
+    }
+    std::stringstream expected;
+    expected << "A4096R" << capa << "F";
+    REQUIRE(log.str() == expected.str());
+  }
+
+#if __cplusplus >= 201103L
+  SECTION("Move construct") {
+    {
+      MyJsonDocument doc1(4096, log);
+      doc1.set(std::string("The size of this string is 32!!"));
+      MyJsonDocument doc2(std::move(doc1));
+
+      REQUIRE(doc2.as<std::string>() == "The size of this string is 32!!");
+      REQUIRE(doc2.capacity() == 4096);
+      REQUIRE(doc1.isNull());
+      REQUIRE(doc1.capacity() == 0);
+    }
+    REQUIRE(log.str() == "A4096FF");
+  }
+
+  SECTION("Move assign") {
+    {
+      MyJsonDocument doc1(4096, log);
+      doc1.set(std::string("The size of this string is 32!!"));
+      MyJsonDocument doc2(8, log);
+      doc2 = std::move(doc1);
+
+      REQUIRE(doc2.as<std::string>() == "The size of this string is 32!!");
+      REQUIRE(doc2.capacity() == 4096);
+      REQUIRE(doc1.isNull());
+      REQUIRE(doc1.capacity() == 0);
+    }
+    REQUIRE(log.str() == "A4096A8FFF");
+  }
+#endif
 }
@@ -0,0 +1,176 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#include <ArduinoJson.h>
+#include <stdlib.h>  // malloc, free
+#include <catch.hpp>
+#include <string>
+
+class ControllableAllocator {
+ public:
+  ControllableAllocator(bool& enabled) : _enabled(&enabled) {}
+
+  void* allocate(size_t n) {
+    return *_enabled ? malloc(n) : 0;
+  }
+
+  void deallocate(void* p) {
+    free(p);
+  }
+
+ private:
+  bool* _enabled;
+};
+
+// the capacity is rounded up to a multiple of the pointer size
+static bool fits(const JsonDocument& doc, size_t usage) {
+  return doc.capacity() >= usage && doc.capacity() < usage + sizeof(void*);
+}
+
+static std::string toJson(const JsonDocument& doc) {
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+TEST_CASE("BasicJsonDocument::garbageCollect()") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("reclaims removed members") {
+    deserializeJson(doc, "{\"dancing\":2,\"bjarne\":\"stroustrup\"}");
+    doc.remove("bjarne");
+    size_t usageBefore = doc.memoryUsage();
+
+    REQUIRE(doc.garbageCollect() == true);
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + 8);
+    REQUIRE(doc.memoryUsage() < usageBefore);
+    REQUIRE(doc.capacity() == 4096);
+    REQUIRE(toJson(doc) == "{\"dancing\":2}");
+  }
+
+  SECTION("reclaims overwritten strings") {
+    doc["key"] = std::string("first value");
+    doc["key"] = std::string("second value");
+
+    REQUIRE(doc.garbageCollect() == true);
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + 13);
+    REQUIRE(toJson(doc) == "{\"key\":\"second value\"}");
+  }
+
+  SECTION("keeps linked strings") {
+    const char* value = "world";
+    doc["hello"] = value;
+
+    REQUIRE(doc.garbageCollect() == true);
+
+    REQUIRE(doc["hello"].as<const char*>() == value);
+  }
+
+  SECTION("preserves nested content and order") {
+    deserializeJson(doc, "{\"a\":[1,{\"b\":true}],\"c\":\"d\",\"e\":null}");
+    doc.remove("c");
+    doc["a"].as<JsonArray>().remove(0);
+
+    REQUIRE(doc.garbageCollect() == true);
+
+    REQUIRE(toJson(doc) == "{\"a\":[{\"b\":true}],\"e\":null}");
+  }
+
+  SECTION("keeps a steady footprint") {
+    for (int i = 0; i < 100; i++) {
+      doc["value"] = std::string("a new string");
+      doc.garbageCollect();
+    }
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + 13);
+  }
+
+  SECTION("returns false when allocation fails") {
+    bool enabled = true;
+    BasicJsonDocument<ControllableAllocator> doc2(4096, enabled);
+    doc2["hello"] = std::string("world");
+    enabled = false;
+
+    REQUIRE(doc2.garbageCollect() == false);
+
+    REQUIRE(toJson(doc2) == "{\"hello\":\"world\"}");
+  }
+}
+
+TEST_CASE("BasicJsonDocument::shrinkToFit()") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("empty document") {
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(doc.capacity() == 0);
+    REQUIRE(doc.isNull());
+  }
+
+  SECTION("reduces the capacity to the memory usage") {
+    deserializeJson(doc, "{\"hello\":[\"world\",42]}");
+    size_t usage = doc.memoryUsage();
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(fits(doc, usage));
+    REQUIRE(doc.memoryUsage() == usage);
+    REQUIRE(toJson(doc) == "{\"hello\":[\"world\",42]}");
+  }
+
+  SECTION("after garbageCollect(), reclaims removed members") {
+    deserializeJson(doc, "{\"dancing\":2,\"bjarne\":\"stroustrup\"}");
+    doc.remove("bjarne");
+
+    REQUIRE(doc.garbageCollect() == true);
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(fits(doc, JSON_OBJECT_SIZE(1) + 8));
+    REQUIRE(toJson(doc) == "{\"dancing\":2}");
+  }
+
+  SECTION("leaves the strings of a mutable input in place") {
+    char json[] = "[\"hello\"]";
+    deserializeJson(doc, json);
+    const char* value = doc[0];
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(fits(doc, JSON_ARRAY_SIZE(1)));
+    REQUIRE(doc[0].as<const char*>() == value);
+  }
+
+  SECTION("moves nested collections and strings") {
+    const char* json = "{\"a\":[1,{\"b\":\"c\"}],\"d\":{\"e\":[\"f\",\"g\"]}}";
+    deserializeJson(doc, json);
+    size_t usage = doc.memoryUsage();
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(fits(doc, usage));
+    REQUIRE(toJson(doc) == json);
+    REQUIRE(doc["d"]["e"][1] == "g");
+  }
+
+  SECTION("the document is full") {
+    deserializeJson(doc, "[1]");
+    doc.shrinkToFit();
+
+    REQUIRE(doc.add(2) == false);
+    REQUIRE(toJson(doc) == "[1]");
+  }
+
+  SECTION("returns false when allocation fails") {
+    bool enabled = true;
+    BasicJsonDocument<ControllableAllocator> doc2(4096, enabled);
+    doc2["hello"] = std::string("world");
+    enabled = false;
+
+    REQUIRE(doc2.shrinkToFit() == false);
+
+    REQUIRE(doc2.capacity() == 4096);
+    REQUIRE(toJson(doc2) == "{\"hello\":\"world\"}");
+  }
+}
@@ -58,6 +58,28 @@ TEST_CASE("JsonObject::remove()") {
     }
   }
 
+  SECTION("erase(iterator)") {
+    SECTION("Erase first") {
+      JsonObject::iterator it = obj.erase(obj.begin());
+      serializeJson(obj, result);
+      REQUIRE("{\"b\":1,\"c\":2}" == result);
+      REQUIRE(it->key() == "b");
+    }
+
+    SECTION("Erase while iterating") {
+      JsonObject::iterator it = obj.begin();
+      while (it != obj.end()) {
+        if (!(it->key() == "b"))
+          it = obj.erase(it);
+        else
+          ++it;
+      }
+      obj["d"] = 3;
+      serializeJson(obj, result);
+      REQUIRE("{\"b\":1,\"d\":3}" == result);
+    }
+  }
+
 #ifdef HAS_VARIABLE_LENGTH_ARRAY
   SECTION("key is a vla") {
     int i = 16;
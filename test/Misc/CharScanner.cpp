@@ -0,0 +1,132 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#define ARDUINOJSON_ENABLE_SIMD 1
+#include <ArduinoJson/Json/CharScanner.hpp>
+#include <catch.hpp>
+
+using namespace ARDUINOJSON_NAMESPACE;
+
+static size_t expectedCount(const char* s, size_t n, char stopChar) {
+  size_t i = 0;
+  while (i < n && s[i] != stopChar && s[i] != '\\' && s[i] != '\0') i++;
+  return i;
+}
+
+// Puts `special` at every position of strings of every length up to 80,
+// so that it falls in the blocks, the words, and the tails
+static void checkAllPositions(char special, char stopChar) {
+  char buffer[81];
+  for (size_t n = 0; n <= 80; n++) {
+    for (size_t pos = 0; pos <= n; pos++) {
+      for (size_t i = 0; i < n; i++)
+        buffer[i] = static_cast<char>('a' + i % 26);
+      if (pos < n) buffer[pos] = special;
+      size_t expected = expectedCount(buffer, n, stopChar);
+
+      CHECK(countPlainChars(buffer, n, stopChar) == expected);
+
+      size_t words = skipPlainWords(buffer, n, stopChar);
+      CHECK(words <= expected);
+      CHECK(expected - words < sizeof(size_t));
+    }
+  }
+}
+
+TEST_CASE("countPlainChars()") {
+  SECTION("Stops at the quote") {
+    checkAllPositions('"', '"');
+  }
+
+  SECTION("Stops at the single quote") {
+    checkAllPositions('\'', '\'');
+  }
+
+  SECTION("Ignores the other quote") {
+    checkAllPositions('\'', '"');
+  }
+
+  SECTION("Stops at backslash") {
+    checkAllPositions('\\', '"');
+  }
+
+  SECTION("Stops at NUL") {
+    checkAllPositions('\0', '"');
+  }
+
+  SECTION("Skips non-ASCII characters") {
+    checkAllPositions('\xE9', '"');
+  }
+
+  SECTION("Skips characters next to the special ones") {
+    checkAllPositions('"' + 1, '"');
+    checkAllPositions('\\' - 1, '"');
+    checkAllPositions('\x01', '"');
+    checkAllPositions('\x80', '"');
+  }
+
+  SECTION("NUL-terminated") {
+    REQUIRE(countPlainChars("", '"') == 0);
+    REQUIRE(countPlainChars("hello", '"') == 5);
+    REQUIRE(countPlainChars("hello\"world", '"') == 5);
+    REQUIRE(countPlainChars("hello\\world", '"') == 5);
+    REQUIRE(countPlainChars("hello'world", '\'') == 5);
+  }
+}
+
+static size_t expectedSpaces(const char* s, size_t n) {
+  size_t i = 0;
+  while (i < n && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r' ||
+                   s[i] == '\n'))
+    i++;
+  return i;
+}
+
+// Fills strings of every length up to 80 with `space`, and puts `other` at
+// every position
+static void checkSpaceRuns(char space, char other, const char* name) {
+  CAPTURE(name);
+  char buffer[81];
+  for (size_t n = 0; n <= 80; n++) {
+    for (size_t pos = 0; pos <= n; pos++) {
+      for (size_t i = 0; i < n; i++) buffer[i] = space;
+      if (pos < n) buffer[pos] = other;
+      size_t expected = expectedSpaces(buffer, n);
+
+      CHECK(countSpaces(buffer, n) == expected);
+
+      size_t words = skipSpaceWords(buffer, n);
+      CHECK(words <= expected);
+    }
+  }
+}
+
+TEST_CASE("countSpaces()") {
+  SECTION("Stops at the first non-space") {
+    checkSpaceRuns(' ', '{', "space");
+    checkSpaceRuns('\t', '"', "tab");
+    checkSpaceRuns('\r', '\0', "CR");
+    checkSpaceRuns('\n', '/', "LF");
+  }
+
+  SECTION("Skips mixed spaces") {
+    checkSpaceRuns(' ', '\n', "LF in spaces");
+    checkSpaceRuns('\t', '\r', "CR in tabs");
+    checkSpaceRuns(' ', '\t', "tab in spaces");
+  }
+
+  SECTION("Stops at characters next to the spaces") {
+    checkSpaceRuns(' ', '!', "!");
+    checkSpaceRuns(' ', '\x1F', "0x1F");
+    checkSpaceRuns('\n', '\x0B', "vertical tab");
+    checkSpaceRuns('\t', '\x08', "backspace");
+  }
+
+  SECTION("NUL-terminated") {
+    REQUIRE(countSpaces("") == 0);
+    REQUIRE(countSpaces("{") == 0);
+    REQUIRE(countSpaces(" \t\r\n{") == 4);
+    REQUIRE(countSpaces("  ") == 2);
+  }
+}
@@ -14,6 +14,38 @@ TEST_CASE("StdStreamReader") {
   REQUIRE(reader.read() == 0x01);
   REQUIRE(reader.read() == 0xFF);
   REQUIRE(reader.read() == -1);
+  REQUIRE(src.eof());
+  REQUIRE(src.fail());
+}
+
+TEST_CASE("StdStreamReader leaves the remaining characters in the stream") {
+  std::istringstream src("ab");
+  StdStreamReader reader(src);
+
+  REQUIRE(reader.read() == 'a');
+  REQUIRE(src.get() == 'b');
+}
+
+TEST_CASE("StdStreamReader doesn't read a failed stream") {
+  std::istringstream src("ab");
+  src.setstate(std::ios::failbit);
+  StdStreamReader reader(src);
+
+  REQUIRE(reader.read() == -1);
+}
+
+TEST_CASE("StdStreamReader::readBytes()") {
+  std::istringstream src("abc");
+  StdStreamReader reader(src);
+  char buffer[4];
+
+  REQUIRE(reader.readBytes(buffer, 2) == 2);
+  REQUIRE(std::string(buffer, 2) == "ab");
+  REQUIRE(reader.readBytes(buffer, 4) == 1);
+  REQUIRE(buffer[0] == 'c');
+  REQUIRE(src.eof());
+  REQUIRE(src.fail());
+  REQUIRE(reader.read() == -1);
 }
 
 TEST_CASE("SafeCharPointerReader") {
@@ -24,6 +56,31 @@ TEST_CASE("SafeCharPointerReader") {
   REQUIRE(reader.read() == -1);
 }
 
+TEST_CASE("SafeCharPointerReader::readBytes()") {
+  SafeCharPointerReader reader("abc", 3);
+  char buffer[4];
+
+  REQUIRE(reader.readBytes(buffer, 2) == 2);
+  REQUIRE(std::string(buffer, 2) == "ab");
+  REQUIRE(reader.readBytes(buffer, 4) == 1);
+  REQUIRE(buffer[0] == 'c');
+  REQUIRE(reader.read() == -1);
+}
+
+TEST_CASE("SafeCharPointerReader::peekSpan()") {
+  SafeCharPointerReader reader("abc", 3);
+  size_t size;
+
+  REQUIRE(std::string(reader.peekSpan(size), 3) == "abc");
+  REQUIRE(size == 3);
+
+  reader.skip(2);
+
+  REQUIRE(reader.peekSpan(size)[0] == 'c');
+  REQUIRE(size == 1);
+  REQUIRE(reader.read() == 'c');
+}
+
 TEST_CASE("UnsafeCharPointerReader") {
   UnsafeCharPointerReader reader("\x01\xFF");
 
@@ -31,3 +88,32 @@ TEST_CASE("UnsafeCharPointerReader") {
   REQUIRE(reader.read() == 0xFF);
   REQUIRE(reader.read() == 0);
 }
+
+TEST_CASE("UnsafeCharPointerReader::readBytes()") {
+  UnsafeCharPointerReader reader("a\0c");
+  char buffer[3];
+
+  REQUIRE(reader.readBytes(buffer, 3) == 3);
+  REQUIRE(std::string(buffer, 3) == std::string("a\0c", 3));
+}
+
+TEST_CASE("ReaderTraits") {
+  typedef IteratorReader<std::string::const_iterator> StringIteratorReader;
+
+  REQUIRE(ReaderTraits<SafeCharPointerReader>::hasReadBytes);
+  REQUIRE(ReaderTraits<SafeCharPointerReader>::hasPeekSpan);
+  REQUIRE(ReaderTraits<StdStreamReader>::hasReadBytes);
+  REQUIRE_FALSE(ReaderTraits<StdStreamReader>::hasPeekSpan);
+  REQUIRE_FALSE(ReaderTraits<StringIteratorReader>::hasReadBytes);
+  REQUIRE_FALSE(ReaderTraits<StringIteratorReader>::hasPeekSpan);
+
+  SECTION("readBytes() falls back to read()") {
+    std::string src("abc");
+    StringIteratorReader reader(src.begin(), src.end());
+    char buffer[4];
+
+    REQUIRE(ReaderTraits<StringIteratorReader>::readBytes(reader, buffer, 4) ==
+            3);
+    REQUIRE(std::string(buffer, 3) == "abc");
+  }
+}
@@ -0,0 +1,19 @@
+#define ARDUINOJSON_CACHE_COLLECTION_SIZE 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_CACHE_COLLECTION_SIZE == 0") {
+  SECTION("CollectionData only holds the head and the tail") {
+    REQUIRE(sizeof(ARDUINOJSON_NAMESPACE::CollectionData) ==
+            2 * sizeof(void*));
+  }
+
+  SECTION("size() counts the elements") {
+    DynamicJsonDocument doc(4096);
+    deserializeJson(doc, "[1,2,3]");
+    doc.remove(1);
+
+    REQUIRE(doc.size() == 2);
+  }
+}
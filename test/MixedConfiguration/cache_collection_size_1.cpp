@@ -0,0 +1,60 @@
+#define ARDUINOJSON_CACHE_COLLECTION_SIZE 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_CACHE_COLLECTION_SIZE == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("CollectionData stores the size") {
+    REQUIRE(sizeof(ARDUINOJSON_NAMESPACE::CollectionData) ==
+            2 * sizeof(void*) + sizeof(size_t));
+  }
+
+  SECTION("JsonArray::size()") {
+    JsonArray arr = doc.to<JsonArray>();
+    arr.add(1);
+    arr.add(2);
+    arr.add(3);
+    REQUIRE(arr.size() == 3);
+
+    arr.remove(1);
+    REQUIRE(arr.size() == 2);
+
+    arr.remove(1);
+    arr.remove(0);
+    REQUIRE(arr.size() == 0);
+
+    arr.add(4);
+    REQUIRE(arr.size() == 1);
+  }
+
+  SECTION("JsonObject::size()") {
+    deserializeJson(doc, "{\"a\":1,\"b\":[1,2],\"c\":{}}");
+    JsonObject obj = doc.as<JsonObject>();
+    REQUIRE(obj.size() == 3);
+    REQUIRE(obj["b"].size() == 2);
+
+    obj.remove("a");
+    REQUIRE(obj.size() == 2);
+
+    obj.clear();
+    REQUIRE(obj.size() == 0);
+  }
+
+  SECTION("copy") {
+    deserializeJson(doc, "[1,2,3,4]");
+    DynamicJsonDocument doc2(doc);
+    REQUIRE(doc2.size() == 4);
+  }
+
+  SECTION("serializeMsgPack()") {
+    deserializeJson(doc, "[1,2,3]");
+    doc.remove(0);
+
+    std::string output;
+    serializeMsgPack(doc, output);
+    REQUIRE(output == "\x92\x02\x03");
+  }
+}
@@ -0,0 +1,17 @@
+#define ARDUINOJSON_ENABLE_ARRAY_INDEX 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_ARRAY_INDEX == 0") {
+  DynamicJsonDocument doc(16384);
+
+  SECTION("getElement() doesn't allocate") {
+    for (int i = 0; i < 50; i++) doc.add(i);
+    size_t memoryUsage = doc.memoryUsage();
+
+    REQUIRE(doc[49] == 49);
+    REQUIRE(doc[50].isNull());
+    REQUIRE(doc.memoryUsage() == memoryUsage);
+  }
+}
@@ -0,0 +1,129 @@
+#define ARDUINOJSON_ENABLE_ARRAY_INDEX 1
+#define ARDUINOJSON_ARRAY_INDEX_THRESHOLD 4
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+static void fill(JsonArray arr, int count) {
+  for (int i = 0; i < count; i++) arr.add(i);
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_ARRAY_INDEX == 1") {
+  DynamicJsonDocument doc(16384);
+  JsonArray arr = doc.to<JsonArray>();
+  fill(arr, 50);
+
+  SECTION("finds all elements") {
+    for (int i = 0; i < 50; i++) REQUIRE(arr[i] == i);
+    REQUIRE(arr[50].isNull());
+    REQUIRE(arr[1000].isNull());
+  }
+
+  SECTION("the index is allocated in the pool") {
+    size_t memoryUsage = doc.memoryUsage();
+    REQUIRE(arr[10] == 10);
+    REQUIRE(doc.memoryUsage() > memoryUsage);
+  }
+
+  SECTION("the index grows in place") {
+    size_t memoryUsage = doc.memoryUsage();
+    REQUIRE(arr[10] == 10);
+    REQUIRE(doc.memoryUsage() - memoryUsage ==
+            ARDUINOJSON_NAMESPACE::CollectionIndex::sizeOf(64));
+  }
+
+  SECTION("small arrays don't get an index") {
+    JsonArray small = arr.createNestedArray();
+    fill(small, 3);
+    size_t memoryUsage = doc.memoryUsage();
+    REQUIRE(small[2] == 2);
+    REQUIRE(small[10].isNull());
+    REQUIRE(doc.memoryUsage() == memoryUsage);
+  }
+
+  SECTION("elements added after the index") {
+    REQUIRE(arr[10] == 10);  // create the index
+    fill(arr, 200);
+    REQUIRE(arr[49] == 49);
+    REQUIRE(arr[50] == 0);
+    REQUIRE(arr[249] == 199);
+    REQUIRE(arr[250].isNull());
+  }
+
+  SECTION("remove()") {
+    REQUIRE(arr[10] == 10);  // create the index
+    arr.remove(49);
+    arr.remove(25);
+    arr.remove(0);
+    REQUIRE(arr.size() == 47);
+    REQUIRE(arr[0] == 1);
+    REQUIRE(arr[23] == 24);
+    REQUIRE(arr[24] == 26);
+    REQUIRE(arr[46] == 48);
+    REQUIRE(arr[47].isNull());
+
+    arr.add(50);
+    REQUIRE(arr[47] == 50);
+  }
+
+  SECTION("remove() from the front") {
+    REQUIRE(arr[10] == 10);  // create the index
+    for (int i = 0; i < 50; i++) {
+      REQUIRE(arr[0] == i);
+      REQUIRE(arr[49 - i] == 49);
+      arr.remove(0);
+    }
+    REQUIRE(arr.size() == 0);
+  }
+
+  SECTION("remove() from the back") {
+    REQUIRE(arr[10] == 10);  // create the index
+    for (int i = 49; i >= 0; i--) {
+      REQUIRE(arr[i] == i);
+      arr.remove(static_cast<size_t>(i));
+    }
+    REQUIRE(arr.size() == 0);
+  }
+
+  SECTION("remove(iterator)") {
+    REQUIRE(arr[10] == 10);  // create the index
+    for (JsonArray::iterator it = arr.begin(); it != arr.end();) {
+      if (it->as<int>() % 2)
+        it = arr.erase(it);
+      else
+        ++it;
+    }
+    REQUIRE(arr.size() == 25);
+    for (int i = 0; i < 25; i++) REQUIRE(arr[i] == 2 * i);
+  }
+
+  SECTION("JsonDocument and JsonVariant") {
+    JsonVariant var = doc.as<JsonVariant>();
+    REQUIRE(doc[30] == 30);
+    REQUIRE(var[40] == 40);
+  }
+
+  SECTION("JsonArrayConst uses the existing index") {
+    REQUIRE(arr[10] == 10);  // create the index
+    arr.add(50);
+    JsonArrayConst carr = arr;
+    REQUIRE(carr[30] == 30);
+    REQUIRE(carr[50] == 50);
+    REQUIRE(carr[51].isNull());
+  }
+
+  SECTION("copy") {
+    REQUIRE(arr[10] == 10);  // create the index
+    DynamicJsonDocument doc2(doc);
+    for (int i = 0; i < 50; i++) REQUIRE(doc2[i] == i);
+  }
+
+  SECTION("shrinkToFit() keeps the index") {
+    REQUIRE(arr[10] == 10);  // create the index
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(doc.capacity() < 16384);
+    for (int i = 0; i < 50; i++) REQUIRE(doc[i] == i);
+  }
+}
@@ -0,0 +1,117 @@
+#define ARDUINOJSON_ENABLE_DOCUMENT_POOL 1
+#include <ArduinoJson.h>
+
+#include <atomic>
+#include <catch.hpp>
+#include <thread>
+#include <utility>  // std::move
+#include <vector>
+
+TEST_CASE("ARDUINOJSON_ENABLE_DOCUMENT_POOL == 1") {
+  JsonDocumentPool pool({64, 256}, 2);
+
+  SECTION("returns the smallest class that fits") {
+    auto small = pool.acquire(10);
+    auto big = pool.acquire(100);
+
+    REQUIRE(small.isPooled());
+    REQUIRE(small->capacity() == 64);
+    REQUIRE(big.isPooled());
+    REQUIRE(big->capacity() == 256);
+  }
+
+  SECTION("skips busy documents") {
+    auto doc1 = pool.acquire(64);
+    auto doc2 = pool.acquire(64);
+    auto doc3 = pool.acquire(64);
+
+    REQUIRE(doc1.isPooled());
+    REQUIRE(doc2.isPooled());
+    REQUIRE(doc3.isPooled());
+    REQUIRE(&*doc1 != &*doc2);
+    REQUIRE(doc1->capacity() == 64);
+    REQUIRE(doc2->capacity() == 64);
+    REQUIRE(doc3->capacity() == 256);
+  }
+
+  SECTION("reuses released documents, cleared") {
+    JsonDocumentPool pool1({64}, 1);
+    JsonDocument* first;
+    {
+      auto doc = pool1.acquire(64);
+      first = &*doc;
+      deserializeJson(*doc, "{\"hello\":\"world\"}");
+      REQUIRE(doc->memoryUsage() > 0);
+    }
+
+    auto doc = pool1.acquire(64);
+
+    REQUIRE(doc.isPooled());
+    REQUIRE(&*doc == first);
+    REQUIRE(doc->isNull());
+    REQUIRE(doc->memoryUsage() == 0);
+  }
+
+  SECTION("release() gives the document back") {
+    JsonDocumentPool pool1({64}, 1);
+    auto doc1 = pool1.acquire(64);
+    doc1.release();
+
+    auto doc2 = pool1.acquire(64);
+
+    REQUIRE(doc2.isPooled());
+  }
+
+  SECTION("allocates a new document when exhausted") {
+    JsonDocumentPool pool1({64}, 1);
+    auto doc1 = pool1.acquire(64);
+    auto doc2 = pool1.acquire(64);
+
+    REQUIRE(doc1.isPooled());
+    REQUIRE_FALSE(doc2.isPooled());
+    REQUIRE(doc2->capacity() == 64);
+  }
+
+  SECTION("allocates a new document when too big") {
+    auto doc = pool.acquire(1000);
+
+    REQUIRE_FALSE(doc.isPooled());
+    REQUIRE(doc->capacity() == 1000);
+  }
+
+  SECTION("handle can be moved") {
+    JsonDocumentPool pool1({64}, 1);
+    auto doc1 = pool1.acquire(64);
+    auto doc2 = std::move(doc1);
+
+    REQUIRE(doc2.isPooled());
+    REQUIRE_FALSE(doc1.isPooled());
+
+    doc2 = pool1.acquire(64);  // the pool is exhausted at this point
+
+    REQUIRE_FALSE(doc2.isPooled());
+    REQUIRE(pool1.acquire(64).isPooled());
+  }
+
+  SECTION("threads acquire and release concurrently") {
+    JsonDocumentPool pool1({64}, 4);
+    std::atomic<int> errors(0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 8; t++) {
+      threads.emplace_back([&pool1, &errors, t] {
+        for (int i = 0; i < 1000; i++) {
+          auto doc = pool1.acquire(64);
+          if (!doc->isNull()) errors++;  // not cleared, or shared
+          doc->set(t);
+          std::this_thread::yield();
+          if (doc->as<int>() != t) errors++;  // shared
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+
+    REQUIRE(errors == 0);
+    REQUIRE(pool1.acquire(64).isPooled());
+  }
+}
@@ -0,0 +1,24 @@
+#define ARDUINOJSON_ENABLE_FREE_LISTS 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_FREE_LISTS == 0") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("remove() leaks the slot") {
+    doc.add(1);
+    doc.add(2);
+    doc.remove(0);
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("set() leaks the previous string") {
+    doc["key"] = std::string("a long enough value");
+    doc["key"] = std::string("another long value!");
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + 2 * 20);
+  }
+}
@@ -0,0 +1,125 @@
+#define ARDUINOJSON_ENABLE_FREE_LISTS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+static std::string toJson(const JsonDocument& doc) {
+  std::string json;
+  serializeJson(doc, json);
+  return json;
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_FREE_LISTS == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("remove() recycles the slot") {
+    doc.add(1);
+    doc.add(2);
+    doc.remove(0);
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+
+    doc.add(3);
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2));
+    REQUIRE(toJson(doc) == "[2,3]");
+  }
+
+  SECTION("remove() recycles the nested values") {
+    deserializeJson(doc, "[{\"a\":1,\"b\":[2,3]},4]");
+    doc.remove(0);
+
+    // the short keys are padded, so they are recycled too
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("set() recycles a short string") {
+    StaticJsonDocument<256> small;
+
+    for (int i = 0; i < 1000; i++) {
+      REQUIRE(small["k"].set(std::string("ab")));
+    }
+
+    REQUIRE(toJson(small) == "{\"k\":\"ab\"}");
+  }
+
+  SECTION("set() recycles the previous string") {
+    doc["key"] = std::string("a long enough value");
+    size_t usage = doc.memoryUsage();
+
+    for (int i = 0; i < 10; i++) {
+      doc["key"] = std::string("another long value!");
+      doc["key"] = std::string("a long enough value");
+    }
+
+    REQUIRE(doc.memoryUsage() == usage);
+    REQUIRE(toJson(doc) == "{\"key\":\"a long enough value\"}");
+  }
+
+  SECTION("set() splits a larger string") {
+    doc.add(std::string("a string that is much larger than two small ones"));
+    doc[0] = 42;
+    doc.add(std::string("first small string"));
+    doc.add(std::string("second small string"));
+
+    REQUIRE(toJson(doc) ==
+            "[42,\"first small string\",\"second small string\"]");
+  }
+
+  SECTION("to<JsonArray>() recycles the previous object") {
+    JsonVariant var = doc.to<JsonVariant>();
+    var["hello"] = std::string("a long enough value");
+    var.to<JsonArray>();
+
+    REQUIRE(doc.memoryUsage() == 0);
+  }
+
+  SECTION("set() copies a nested value before recycling") {
+    deserializeJson(doc, "{\"outer\":{\"inner\":\"this is a long value\"}}");
+    doc.as<JsonVariant>().set(doc["outer"]);
+
+    REQUIRE(toJson(doc) == "{\"inner\":\"this is a long value\"}");
+  }
+
+  SECTION("remove() while iterating") {
+    deserializeJson(doc, "[1,2,3,4,5]");
+    JsonArray arr = doc.as<JsonArray>();
+    for (JsonArray::iterator it = arr.begin(); it != arr.end(); ++it) {
+      if (it->as<int>() % 2 == 0) arr.remove(it);
+    }
+
+    REQUIRE(toJson(doc) == "[1,3,5]");
+  }
+
+  SECTION("ignores strings outside of the pool") {
+    char input[] = "{\"key\":\"a value in the input buffer\"}";
+    deserializeJson(doc, input);
+    const char* value = doc["key"];
+    doc.remove("key");
+    doc["other"] = std::string("a long value to allocate");
+
+    REQUIRE(toJson(doc) == "{\"other\":\"a long value to allocate\"}");
+    REQUIRE(std::string(value) == "a value in the input buffer");
+  }
+
+  SECTION("shrinkToFit() keeps the free lists") {
+    doc.add(1);
+    doc.add(std::string("a long enough value"));
+    doc.add(2);
+    doc.remove(1);
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(doc.add(std::string("another value")) == true);
+    REQUIRE(toJson(doc) == "[1,2,\"another value\"]");
+  }
+
+  SECTION("clear() empties the free lists") {
+    doc.add(std::string("a long enough value"));
+    doc.remove(0);
+    doc.clear();
+
+    REQUIRE(doc.memoryUsage() == 0);
+  }
+}
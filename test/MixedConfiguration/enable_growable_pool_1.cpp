@@ -0,0 +1,159 @@
+#define ARDUINOJSON_ENABLE_GROWABLE_POOL 1
+#include <ArduinoJson.h>
+
+#include <algorithm>  // std::count
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+#include <utility>  // std::move
+
+class SpyingAllocator {
+ public:
+  SpyingAllocator(std::ostream& log) : _log(&log) {}
+
+  void* allocate(size_t n) {
+    *_log << "A";
+    return malloc(n);
+  }
+  void deallocate(void* p) {
+    *_log << "F";
+    free(p);
+  }
+
+ private:
+  std::ostream* _log;
+};
+
+TEST_CASE("ARDUINOJSON_ENABLE_GROWABLE_POOL == 1") {
+  SECTION("deserializeJson() chains blocks") {
+    DynamicJsonDocument doc(JSON_ARRAY_SIZE(2));
+
+    DeserializationError err =
+        deserializeJson(doc, "[1,2,3,{\"hello\":\"world\"},[4,5,6]]");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.capacity() > JSON_ARRAY_SIZE(2));
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(8) + JSON_OBJECT_SIZE(1) +
+                                     JSON_STRING_SIZE(12));
+
+    std::string json;
+    serializeJson(doc, json);
+    REQUIRE(json == "[1,2,3,{\"hello\":\"world\"},[4,5,6]]");
+  }
+
+  SECTION("deserializeJson() continues reading a std::istream") {
+    DynamicJsonDocument doc(JSON_OBJECT_SIZE(1));
+    std::istringstream json("{\"a\":[1,2,3],\"b\":\"hello\",\"c\":{}}");
+
+    DeserializationError err = deserializeJson(doc, json);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() ==
+            "{\"a\":[1,2,3],\"b\":\"hello\",\"c\":{}}");
+  }
+
+  SECTION("deserializeMsgPack() chains blocks") {
+    DynamicJsonDocument doc(JSON_ARRAY_SIZE(1));
+
+    DeserializationError err =
+        deserializeMsgPack(doc, "\x93\x01\xA5hello\x81\xA1x\x02");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == "[1,\"hello\",{\"x\":2}]");
+  }
+
+  SECTION("garbageCollect() merges the blocks") {
+    std::stringstream log;
+    BasicJsonDocument<SpyingAllocator> doc(JSON_ARRAY_SIZE(1), log);
+    deserializeJson(doc, "[1,2,3,4,5]");
+    size_t capacity = doc.capacity();
+    std::string allocations = log.str();
+    REQUIRE(allocations.size() > 1);
+
+    REQUIRE(doc.garbageCollect());
+    std::string expected =
+        allocations + "A" + std::string(allocations.size(), 'F');
+    REQUIRE(log.str() == expected);
+    REQUIRE(doc.capacity() == capacity);
+    REQUIRE(doc.as<std::string>() == "[1,2,3,4,5]");
+
+    doc.clear();
+    REQUIRE(deserializeJson(doc, "[1,2,3,4,5]") == DeserializationError::Ok);
+    REQUIRE(log.str() == expected);  // no new block
+  }
+
+  SECTION("shrinkToFit() merges the blocks") {
+    DynamicJsonDocument doc(JSON_ARRAY_SIZE(1));
+    deserializeJson(doc, "[1,2,3,{\"hello\":\"world\"}]");
+    size_t capacity = doc.capacity();
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(doc.capacity() < capacity);
+    REQUIRE(doc.as<std::string>() == "[1,2,3,{\"hello\":\"world\"}]");
+  }
+
+  SECTION("a string can span beyond the first block") {
+    DynamicJsonDocument doc(8);
+    std::string value(1000, 'x');
+
+    DeserializationError err = deserializeJson(doc, "\"" + value + "\"");
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == value);
+  }
+
+  SECTION("set() and add() chain blocks") {
+    DynamicJsonDocument doc(JSON_OBJECT_SIZE(1));
+
+    for (int i = 0; i < 100; i++) {
+      doc["values"].add(i);
+      doc["strings"].add(std::string("abc"));
+    }
+
+    REQUIRE(doc["values"].size() == 100);
+    REQUIRE(doc["values"][99] == 99);
+    REQUIRE(doc["strings"][99] == "abc");
+  }
+
+  SECTION("clear() releases the extra blocks") {
+    std::stringstream log;
+    {
+      BasicJsonDocument<SpyingAllocator> doc(JSON_ARRAY_SIZE(1), log);
+      deserializeJson(doc, "[1,2]");
+      REQUIRE(log.str() == "AA");
+
+      doc.clear();
+      REQUIRE(log.str() == "AAF");
+      REQUIRE(doc.capacity() == JSON_ARRAY_SIZE(1));
+    }
+    REQUIRE(log.str() == "AAFF");
+  }
+
+  SECTION("a moved document keeps its blocks") {
+    std::stringstream log;
+    {
+      BasicJsonDocument<SpyingAllocator> doc2(JSON_ARRAY_SIZE(1), log);
+      {
+        BasicJsonDocument<SpyingAllocator> doc1(JSON_ARRAY_SIZE(1), log);
+        deserializeJson(doc1, "[1,2]");
+        doc2 = std::move(doc1);
+      }
+      REQUIRE(log.str() == "AAAFF");  // doc2's buffer, then empty doc1
+
+      doc2.add(3);
+      REQUIRE(doc2.as<std::string>() == "[1,2,3]");
+    }
+    std::string calls = log.str();
+    REQUIRE(std::count(calls.begin(), calls.end(), 'A') ==
+            std::count(calls.begin(), calls.end(), 'F') - 1);  // + empty doc1
+  }
+
+  SECTION("StaticJsonDocument doesn't grow") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(2)> doc;
+
+    DeserializationError err = deserializeJson(doc, "[1,2,3]");
+
+    REQUIRE(err == DeserializationError::NoMemory);
+  }
+}
@@ -0,0 +1,22 @@
+#define ARDUINOJSON_ENABLE_GROWABLE_POOL 1
+#define ARDUINOJSON_ENABLE_FREE_LISTS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_GROWABLE_POOL == 1 && FREE_LISTS == 1") {
+  SECTION("memoryUsage() ignores the free strings, after growing") {
+    DynamicJsonDocument doc(JSON_ARRAY_SIZE(2) + 32);
+    JsonArray array = doc.to<JsonArray>();
+    array.add(std::string("The size of this string is 32!!"));
+    array.add(2);
+
+    array.remove(0);  // the string goes in the free list
+    array.add(3);
+    array.add(4);  // the pool grows
+
+    REQUIRE(doc.capacity() > JSON_ARRAY_SIZE(2) + 32);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(3));
+  }
+}
@@ -0,0 +1,13 @@
+#define ARDUINOJSON_ENABLE_INLINE_STRINGS 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_INLINE_STRINGS == 0") {
+  DynamicJsonDocument doc(4096);
+
+  deserializeJson(doc, "[\"ok\"]");
+
+  REQUIRE(doc[0] == "ok");
+  REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(3));
+}
@@ -0,0 +1,87 @@
+#define ARDUINOJSON_ENABLE_INLINE_STRINGS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_INLINE_STRINGS == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("deserializeJson()") {
+    deserializeJson(doc, "[\"ok\",\"on\",\"C\"]");
+
+    REQUIRE(doc[0] == "ok");
+    REQUIRE(doc[1] == "on");
+    REQUIRE(doc[2] == "C");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(3));
+    REQUIRE(doc.as<std::string>() == "[\"ok\",\"on\",\"C\"]");
+  }
+
+  SECTION("deserializeMsgPack()") {
+    deserializeMsgPack(doc, "\x91\xA2ok");
+
+    REQUIRE(doc[0] == "ok");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("longest inline string") {
+    std::string s(sizeof(void*) * 2 - 1, 'x');
+    doc.set(s);
+
+    REQUIRE(doc.as<std::string>() == s);
+    REQUIRE(doc.memoryUsage() == 0);
+  }
+
+  SECTION("long strings stay in the pool") {
+    std::string s(sizeof(void*) * 2, 'x');
+    doc.set(s);
+
+    REQUIRE(doc.as<std::string>() == s);
+    REQUIRE(doc.memoryUsage() == JSON_STRING_SIZE(s.size() + 1));
+  }
+
+  SECTION("the pool takes the string back") {
+    doc.add(std::string("ok"));
+    doc.add(std::string("hello world, hello world"));
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + JSON_STRING_SIZE(25));
+  }
+
+  SECTION("conversions") {
+    deserializeJson(doc, "[\"42\",\"true\",\"1.5\"]");
+
+    REQUIRE(doc[0].as<int>() == 42);
+    REQUIRE(doc[1].as<bool>() == true);
+    REQUIRE(doc[2].as<float>() == 1.5f);
+    REQUIRE(doc[0].is<const char*>());
+  }
+
+  SECTION("copy and compare") {
+    DynamicJsonDocument doc2(4096);
+    deserializeJson(doc, "{\"a\":\"ok\"}");
+    doc2.set(doc);
+
+    REQUIRE(doc2["a"] == "ok");
+    REQUIRE(doc.as<JsonVariant>() == doc2.as<JsonVariant>());
+
+    doc2["a"] = std::string("ko");
+    REQUIRE(doc.as<JsonVariant>() != doc2.as<JsonVariant>());
+  }
+
+  SECTION("overwrite with itself") {
+    doc.set(std::string("ok"));
+    doc.set(const_cast<char*>(doc.as<const char*>()));
+
+    REQUIRE(doc.as<std::string>() == "ok");
+  }
+
+  SECTION("shrinkToFit()") {
+    deserializeJson(doc, "{\"a\":\"ok\",\"b\":\"a longer string\"}");
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(doc.capacity() < 4096);
+    REQUIRE(doc["a"] == "ok");
+    REQUIRE(doc["b"] == "a longer string");
+  }
+}
@@ -0,0 +1,14 @@
+#define ARDUINOJSON_ENABLE_KEY_FINGERPRINT 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_KEY_FINGERPRINT == 0") {
+  DynamicJsonDocument doc(4096);
+
+  deserializeJson(doc, "{\"hello\":1,\"world\":2}");
+
+  REQUIRE(doc["hello"] == 1);
+  REQUIRE(doc["world"] == 2);
+  REQUIRE(doc["unknown"].isNull());
+}
@@ -0,0 +1,56 @@
+#define ARDUINOJSON_ENABLE_KEY_FINGERPRINT 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_KEY_FINGERPRINT == 1") {
+  DynamicJsonDocument doc(16384);
+
+  SECTION("deserialized keys") {
+    deserializeJson(doc, "{\"hello\":1,\"world\":2}");
+
+    REQUIRE(doc["hello"] == 1);
+    REQUIRE(doc["world"] == 2);
+    REQUIRE(doc["unknown"].isNull());
+    REQUIRE(doc[std::string("world")] == 2);
+  }
+
+  SECTION("linked and owned keys") {
+    doc["linked"] = 1;
+    doc[std::string("owned")] = 2;
+
+    REQUIRE(doc[std::string("linked")] == 1);
+    REQUIRE(doc["owned"] == 2);
+  }
+
+  SECTION("many keys") {
+    for (int i = 0; i < 300; i++) {
+      std::ostringstream key;
+      key << i;
+      doc[key.str()] = i;
+    }
+    for (int i = 0; i < 300; i++) {
+      std::ostringstream key;
+      key << i;
+      REQUIRE(doc[key.str()] == i);
+    }
+    REQUIRE(doc["300"].isNull());
+  }
+
+  SECTION("remove()") {
+    deserializeJson(doc, "{\"a\":1,\"b\":2,\"c\":3}");
+    doc.remove("b");
+
+    REQUIRE(doc.as<std::string>() == "{\"a\":1,\"c\":3}");
+  }
+
+  SECTION("operator==") {
+    DynamicJsonDocument doc2(4096);
+    deserializeJson(doc, "{\"a\":1,\"b\":2}");
+    deserializeJson(doc2, "{\"b\":2,\"a\":1}");
+
+    REQUIRE(doc.as<JsonObject>() == doc2.as<JsonObject>());
+  }
+}
@@ -0,0 +1,13 @@
+#define ARDUINOJSON_ENABLE_LINKED_INPUT 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_LINKED_INPUT == 0") {
+  DynamicJsonDocument doc(4096);
+
+  deserializeJson(doc, "[\"hello\"]");
+
+  REQUIRE(doc[0] == "hello");
+  REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(6));
+}
@@ -0,0 +1,105 @@
+#define ARDUINOJSON_ENABLE_LINKED_INPUT 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_LINKED_INPUT == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("deserializeJson(const char*)") {
+    const char* input = "{\"hello\":\"world\"}";
+    deserializeJson(doc, input);
+
+    REQUIRE(doc["hello"].as<std::string>() == "world");
+    REQUIRE(doc["hello"].is<std::string>());
+    REQUIRE(doc["hello"].is<const char*>() == false);
+    REQUIRE(doc["hello"].as<const char*>() == 0);
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(6));
+    REQUIRE(doc.as<std::string>() == input);
+  }
+
+  SECTION("comparisons") {
+    deserializeJson(doc, "{\"status\":\"ok\"}");
+
+    REQUIRE(doc["status"] == "ok");
+    REQUIRE("ok" == doc["status"]);
+    REQUIRE(doc["status"] == std::string("ok"));
+    REQUIRE(doc["status"] != "o");
+    REQUIRE(doc["status"] != "okay");
+    REQUIRE(doc.as<JsonObject>()["status"] == "ok");
+    REQUIRE(doc.as<JsonVariantConst>()["status"] == "ok");
+  }
+
+  SECTION("conversions") {
+    deserializeJson(doc, "[\"42\",\"true\",\"1.5\",\"truest\"]");
+
+    REQUIRE(doc[0].as<int>() == 42);
+    REQUIRE(doc[1].as<bool>() == true);
+    REQUIRE(doc[2].as<float>() == 1.5f);
+    REQUIRE(doc[3].as<bool>() == false);
+  }
+
+  SECTION("std::string input is copied") {
+    deserializeJson(doc, std::string("[\"hello\"]"));
+
+    REQUIRE(doc[0] == "hello");
+    REQUIRE(doc[0].is<const char*>());
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(6));
+  }
+
+  SECTION("escaped values are copied") {
+    deserializeJson(doc, "[\"hello\\n\"]");
+
+    REQUIRE(doc[0] == "hello\n");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1) + JSON_STRING_SIZE(7));
+  }
+
+  SECTION("a writable input is still decoded in place") {
+    char input[] = "[\"hello\"]";
+    deserializeJson(doc, input);
+
+    REQUIRE(doc[0] == "hello");
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("deserializeMsgPack()") {
+    const char* input = "\x81\xA5hello\xA5world";
+    deserializeMsgPack(doc, input, 13);
+
+    REQUIRE(doc["hello"] == "world");
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(6));
+  }
+
+  SECTION("incomplete MsgPack string") {
+    const char* input = "\x91\xA5hel";
+
+    REQUIRE(deserializeMsgPack(doc, input, 5) ==
+            DeserializationError::IncompleteInput);
+  }
+
+  SECTION("copy to another document") {
+    DynamicJsonDocument doc2(4096);
+    deserializeJson(doc, "[\"hello\"]");
+    doc2.set(doc);
+
+    REQUIRE(doc2[0] == "hello");
+    REQUIRE(doc.as<JsonVariant>() == doc2.as<JsonVariant>());
+  }
+
+  SECTION("equals the same string in the pool") {
+    DynamicJsonDocument doc2(4096);
+    deserializeJson(doc, "[\"hello\"]");
+    deserializeJson(doc2, std::string("[\"hello\"]"));
+
+    REQUIRE(doc.as<JsonVariant>() == doc2.as<JsonVariant>());
+    REQUIRE(doc2.as<JsonVariant>() == doc.as<JsonVariant>());
+  }
+
+  SECTION("measureDeserializeJson() counts the values as copies") {
+    const char* input = "[\"hello\"]";
+    deserializeJson(doc, input);
+
+    REQUIRE(measureDeserializeJson(input) >= doc.memoryUsage());
+  }
+}
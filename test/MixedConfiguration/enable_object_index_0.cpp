@@ -0,0 +1,22 @@
+#define ARDUINOJSON_ENABLE_OBJECT_INDEX 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <sstream>
+
+TEST_CASE("ARDUINOJSON_ENABLE_OBJECT_INDEX == 0") {
+  DynamicJsonDocument doc(16384);
+
+  SECTION("lookup doesn't allocate") {
+    for (int i = 0; i < 50; i++) {
+      std::ostringstream key;
+      key << "key" << i;
+      doc[key.str()] = i;
+    }
+    size_t memoryUsage = doc.memoryUsage();
+
+    REQUIRE(doc["key49"] == 49);
+    REQUIRE(doc["unknown"].isNull());
+    REQUIRE(doc.memoryUsage() == memoryUsage);
+  }
+}
@@ -0,0 +1,142 @@
+#define ARDUINOJSON_ENABLE_OBJECT_INDEX 1
+#define ARDUINOJSON_OBJECT_INDEX_THRESHOLD 4
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <sstream>
+#include <string>
+
+static std::string keyOf(int i) {
+  std::ostringstream key;
+  key << "key" << i;
+  return key.str();
+}
+
+static void fill(JsonObject obj, int count) {
+  for (int i = 0; i < count; i++) obj[keyOf(i)] = i;
+}
+
+TEST_CASE("ARDUINOJSON_ENABLE_OBJECT_INDEX == 1") {
+  DynamicJsonDocument doc(16384);
+  JsonObject obj = doc.to<JsonObject>();
+  fill(obj, 50);
+
+  SECTION("finds all members") {
+    for (int i = 0; i < 50; i++) REQUIRE(obj[keyOf(i)] == i);
+    REQUIRE(obj["unknown"].isNull());
+    REQUIRE(obj.containsKey("key42"));
+    REQUIRE_FALSE(obj.containsKey("key50"));
+  }
+
+  SECTION("the index is allocated in the pool") {
+    deserializeJson(doc, "{\"a\":1,\"b\":2,\"c\":3,\"d\":4,\"e\":5}");
+    size_t memoryUsage = doc.memoryUsage();
+    REQUIRE(doc["e"] == 5);
+    REQUIRE(doc.memoryUsage() > memoryUsage);
+  }
+
+  SECTION("the index is built at once") {
+    std::ostringstream json;
+    json << "{\"key0\":0";
+    for (int i = 1; i < 50; i++) json << ",\"" << keyOf(i) << "\":" << i;
+    json << "}";
+    deserializeJson(doc, json.str());
+    size_t memoryUsage = doc.memoryUsage();
+    REQUIRE(doc["key49"] == 49);
+    // 50 members need 128 buckets, because a quarter must stay empty
+    REQUIRE(doc.memoryUsage() - memoryUsage ==
+            ARDUINOJSON_NAMESPACE::CollectionIndex::sizeOf(128));
+  }
+
+  SECTION("small objects don't get an index") {
+    JsonObject small = obj.createNestedObject("small");
+    fill(small, 3);
+    size_t memoryUsage = doc.memoryUsage();
+    REQUIRE(small["key2"] == 2);
+    REQUIRE(small["unknown"].isNull());
+    REQUIRE(doc.memoryUsage() == memoryUsage);
+  }
+
+  SECTION("members added after the index") {
+    REQUIRE(obj["key0"] == 0);  // create the index
+    obj["extra"] = 1;
+    fill(obj, 200);
+    REQUIRE(obj["extra"] == 1);
+    for (int i = 0; i < 200; i++) REQUIRE(obj[keyOf(i)] == i);
+    REQUIRE(obj.size() == 201);
+  }
+
+  SECTION("remove()") {
+    REQUIRE(obj["key0"] == 0);  // create the index
+    obj.remove("key0");
+    obj.remove("key25");
+    obj.remove("key49");
+    REQUIRE(obj["key0"].isNull());
+    REQUIRE(obj["key25"].isNull());
+    REQUIRE(obj["key49"].isNull());
+    REQUIRE(obj["key1"] == 1);
+    REQUIRE(obj["key48"] == 48);
+
+    obj["key25"] = 25;
+    REQUIRE(obj["key25"] == 25);
+    REQUIRE(obj.size() == 48);
+  }
+
+  SECTION("erase()") {
+    REQUIRE(obj["key0"] == 0);  // create the index
+    for (JsonObject::iterator it = obj.begin(); it != obj.end();) {
+      if (it->value().as<int>() % 2)
+        it = obj.erase(it);
+      else
+        ++it;
+    }
+    for (int i = 0; i < 50; i++) {
+      if (i % 2)
+        REQUIRE(obj[keyOf(i)].isNull());
+      else
+        REQUIRE(obj[keyOf(i)] == i);
+    }
+  }
+
+  SECTION("clear()") {
+    REQUIRE(obj["key0"] == 0);  // create the index
+    obj.clear();
+    REQUIRE(obj["key0"].isNull());
+    fill(obj, 10);
+    REQUIRE(obj["key9"] == 9);
+  }
+
+  SECTION("copy") {
+    REQUIRE(obj["key0"] == 0);  // create the index
+    DynamicJsonDocument doc2(doc);
+    for (int i = 0; i < 50; i++) REQUIRE(doc2[keyOf(i)] == i);
+    REQUIRE(doc2.as<JsonVariant>() == doc.as<JsonVariant>());
+  }
+
+  SECTION("JsonObjectConst uses the existing index") {
+    REQUIRE(obj["key0"] == 0);  // create the index
+    obj["extra"] = 1;
+    JsonObjectConst cobj = obj;
+    REQUIRE(cobj["key30"] == 30);
+    REQUIRE(cobj["extra"] == 1);
+    REQUIRE(cobj["unknown"].isNull());
+  }
+
+  SECTION("deserializeJson() keeps the first duplicate") {
+    deserializeJson(doc,
+                    "{\"a\":1,\"b\":2,\"c\":3,\"d\":4,\"e\":5,\"a\":6,\"f\":7}");
+    REQUIRE(doc["f"] == 7);  // create the index
+    REQUIRE(doc["a"] == 1);
+    doc.remove("a");
+    REQUIRE(doc["a"] == 6);
+  }
+
+  SECTION("shrinkToFit() keeps the index") {
+    REQUIRE(obj["key10"] == 10);  // create the index
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(doc.capacity() < 16384);
+    for (int i = 0; i < 50; i++) REQUIRE(doc[keyOf(i)] == i);
+  }
+}
@@ -0,0 +1,69 @@
+#define ARDUINOJSON_ENABLE_POOL_STATS 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_POOL_STATS == 1") {
+  DynamicJsonDocument doc(4096);
+  const char* input = "{\"hello\":\"world\",\"a\":[1,2]}";
+
+  SECTION("empty document") {
+    MemoryPoolStats stats = doc.memoryStats();
+
+    REQUIRE(stats.stringBytes == 0);
+    REQUIRE(stats.slotBytes == 0);
+    REQUIRE(stats.slotCount == 0);
+    REQUIRE(stats.freeBytes == 0);
+    REQUIRE(stats.deadBytes == 0);
+    REQUIRE(stats.peakUsage == 0);
+  }
+
+  SECTION("separates strings and slots") {
+    deserializeJson(doc, input);
+
+    MemoryPoolStats stats = doc.memoryStats();
+
+    REQUIRE(stats.stringBytes ==
+            JSON_STRING_SIZE(6) + JSON_STRING_SIZE(6) + JSON_STRING_SIZE(2));
+    REQUIRE(stats.slotBytes == JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(2));
+    REQUIRE(stats.slotCount == 4);
+    REQUIRE(stats.freeBytes == 0);
+    REQUIRE(stats.deadBytes == 0);
+    REQUIRE(stats.stringBytes + stats.slotBytes == doc.memoryUsage());
+  }
+
+  SECTION("counts the bytes leaked by remove()") {
+    deserializeJson(doc, input);
+    size_t usage = doc.memoryUsage();
+
+    doc.remove("hello");
+    MemoryPoolStats stats = doc.memoryStats();
+
+    REQUIRE(doc.memoryUsage() == usage);
+    REQUIRE(stats.slotCount == 4);
+    REQUIRE(stats.deadBytes ==
+            JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(6) + JSON_STRING_SIZE(6));
+  }
+
+  SECTION("garbageCollect() reclaims the dead bytes") {
+    deserializeJson(doc, input);
+    doc.remove("hello");
+
+    REQUIRE(doc.garbageCollect());
+    MemoryPoolStats stats = doc.memoryStats();
+
+    REQUIRE(stats.slotCount == 3);
+    REQUIRE(stats.deadBytes == 0);
+  }
+
+  SECTION("peakUsage is kept by clear()") {
+    deserializeJson(doc, input);
+    size_t usage = doc.memoryUsage();
+
+    deserializeJson(doc, "[1]");
+    MemoryPoolStats stats = doc.memoryStats();
+
+    REQUIRE(stats.slotCount == 1);
+    REQUIRE(stats.peakUsage == usage);
+  }
+}
@@ -0,0 +1,14 @@
+#define ARDUINOJSON_ENABLE_SIMD 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_SIMD == 0") {
+  DynamicJsonDocument doc(4096);
+  std::string s(100, 'x');
+
+  deserializeJson(doc, "[\"" + s + "\"]");
+
+  REQUIRE(doc[0] == s);
+}
@@ -0,0 +1,29 @@
+#define ARDUINOJSON_ENABLE_SIMD 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_SIMD == 1") {
+  DynamicJsonDocument doc(4096);
+  std::string s(100, 'x');
+  std::string spaces(100, ' ');
+
+  SECTION("long string") {
+    deserializeJson(doc, "[\"" + s + "\"]");
+
+    REQUIRE(doc[0] == s);
+  }
+
+  SECTION("escape after a block") {
+    deserializeJson(doc, "[\"" + s + "\\n" + s + "\"]");
+
+    REQUIRE(doc[0] == s + "\n" + s);
+  }
+
+  SECTION("long run of spaces") {
+    deserializeJson(doc, "[" + spaces + "1," + spaces + "2" + spaces + "]");
+
+    REQUIRE(doc.as<std::string>() == "[1,2]");
+  }
+}
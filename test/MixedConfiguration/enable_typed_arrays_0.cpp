@@ -0,0 +1,25 @@
+#define ARDUINOJSON_ENABLE_TYPED_ARRAYS 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+
+TEST_CASE("ARDUINOJSON_ENABLE_TYPED_ARRAYS == 0") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("deserializeJson()") {
+    deserializeJson(doc, "[1,2,3]");
+
+    REQUIRE(doc[1] == 2);
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(3));
+  }
+
+  SECTION("copyArray()") {
+    int src[] = {1, 2, 3};
+    int dst[3];
+    copyArray(src, doc);
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(3));
+    REQUIRE(copyArray(doc, dst) == 3);
+    REQUIRE(dst[2] == 3);
+  }
+}
@@ -0,0 +1,233 @@
+#define ARDUINOJSON_ENABLE_TYPED_ARRAYS 1
+#include <ArduinoJson.h>
+
+#include <stdint.h>
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_ENABLE_TYPED_ARRAYS == 1") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("int8") {
+    deserializeJson(doc, "[1,2,-3]");
+
+    REQUIRE(doc.memoryUsage() == 3);
+    REQUIRE(doc.size() == 3);
+    REQUIRE(doc.is<JsonArray>());
+    REQUIRE(doc.as<std::string>() == "[1,2,-3]");
+  }
+
+  SECTION("int16") {
+    deserializeJson(doc, "[1,-300]");
+
+    REQUIRE(doc.memoryUsage() == 4);
+    REQUIRE(doc.as<std::string>() == "[1,-300]");
+  }
+
+  SECTION("int32") {
+    deserializeJson(doc, "[1,70000]");
+
+    REQUIRE(doc.memoryUsage() == 8);
+    REQUIRE(doc.as<std::string>() == "[1,70000]");
+  }
+
+  SECTION("floats") {
+    deserializeJson(doc, "[1.5,2.5]");
+
+    REQUIRE(doc.memoryUsage() == 2 * sizeof(double));
+    REQUIRE(doc.as<std::string>() == "[1.5,2.5]");
+  }
+
+  SECTION("integers and floats fall back to slots") {
+    deserializeJson(doc, "[1,2.5,300]");
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(3));
+    REQUIRE(doc[0].is<int>());
+    REQUIRE(doc[1].is<float>());
+    REQUIRE(doc[2].is<int>());
+    REQUIRE(doc.as<std::string>() == "[1,2.5,300]");
+  }
+
+  SECTION("floats and integers fall back to slots") {
+    deserializeJson(doc, "[0.5,1]");
+
+    REQUIRE(doc[0].is<float>());
+    REQUIRE(doc[1].is<int>());
+    REQUIRE(doc.as<std::string>() == "[0.5,1]");
+  }
+
+  SECTION("large integers keep their value next to a float") {
+    deserializeJson(doc, "[9007199254740993,0.5]");
+
+    REQUIRE(doc[0].as<int64_t>() == 9007199254740993LL);
+    REQUIRE(doc.as<std::string>() == "[9007199254740993,0.5]");
+  }
+
+  SECTION("serializeMsgPack() of integers and floats") {
+    deserializeJson(doc, "[1,2.5]");
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+
+    REQUIRE(msgpack == std::string("\x92\x01\xCA\x40\x20\x00\x00", 7));
+  }
+
+  SECTION("serializeJsonPretty()") {
+    deserializeJson(doc, "[1,2]");
+    std::string json;
+    serializeJsonPretty(doc, json);
+
+    REQUIRE(json == "[\r\n  1,\r\n  2\r\n]");
+  }
+
+  SECTION("serializeMsgPack()") {
+    deserializeJson(doc, "[1,-1]");
+    std::string msgpack;
+    serializeMsgPack(doc, msgpack);
+
+    REQUIRE(msgpack == "\x92\x01\xFF");
+  }
+
+  SECTION("falls back to slots when an element is not a number") {
+    deserializeJson(doc, "[1,2,\"a\",[3]]");
+
+    REQUIRE(doc.memoryUsage() ==
+            JSON_ARRAY_SIZE(4) + JSON_STRING_SIZE(2) + 1);
+    REQUIRE(doc.as<std::string>() == "[1,2,\"a\",[3]]");
+  }
+
+  SECTION("falls back to slots when a number is too big") {
+    deserializeJson(doc, "[1,18446744073709551615,3]");
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(3));
+    REQUIRE(doc.as<std::string>() == "[1,18446744073709551615,3]");
+  }
+
+  SECTION("NoMemory") {
+    StaticJsonDocument<2> small;
+
+    REQUIRE(deserializeJson(small, "[1,2,3]") ==
+            DeserializationError::NoMemory);
+  }
+
+  SECTION("modifying an element converts to slots") {
+    deserializeJson(doc, "{\"a\":[1,2,3]}");
+    doc["a"][1] = 42;
+
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(2) +
+                                     JSON_ARRAY_SIZE(3));
+    REQUIRE(doc.as<std::string>() == "{\"a\":[1,42,3]}");
+  }
+
+  SECTION("const access reads the elements in place") {
+    deserializeJson(doc, "{\"a\":[1,2,3]}");
+    const JsonDocument& cdoc = doc;
+    JsonArrayConst array = cdoc["a"].as<JsonArrayConst>();
+
+    REQUIRE(array.isNull() == false);
+    REQUIRE(array.size() == 3);
+    REQUIRE(array[1] == 2);
+    REQUIRE(array[3].isNull());
+    REQUIRE(cdoc["a"][2] == 3);
+
+    int sum = 0;
+    for (JsonArrayConst::iterator it = array.begin(); it != array.end(); ++it)
+      sum += it->as<int>();
+    REQUIRE(sum == 6);
+
+    JsonVariantConst first = *array.begin();
+    JsonVariantConst copy = first;
+    REQUIRE(copy == 1);
+
+    REQUIRE(doc.memoryUsage() ==
+            JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(2) + 3);
+  }
+
+  SECTION("const access to a typed array at the root") {
+    deserializeJson(doc, "[1,2,3]");
+    const JsonDocument& cdoc = doc;
+
+    REQUIRE(cdoc[1] == 2);
+    REQUIRE(cdoc.as<JsonArrayConst>().size() == 3);
+    REQUIRE(doc.memoryUsage() == 3);
+  }
+
+  SECTION("JsonArray::set() from a typed array") {
+    DynamicJsonDocument doc2(4096);
+    deserializeJson(doc, "[1,2,3]");
+    JsonArray array = doc2.to<JsonArray>();
+
+    REQUIRE(array.set(doc.as<JsonArrayConst>()));
+    REQUIRE(doc2.as<std::string>() == "[1,2,3]");
+    REQUIRE(doc.as<JsonArrayConst>() == array);
+  }
+
+  SECTION("a failed conversion gives back the slots") {
+    StaticJsonDocument<JSON_ARRAY_SIZE(2) + 8> small;
+    deserializeJson(small, "[1,2,3]");
+
+    REQUIRE(small.add(4) == false);
+
+    REQUIRE(small.memoryUsage() == 3);
+    REQUIRE(small.as<std::string>() == "[1,2,3]");
+  }
+
+  SECTION("copy and compare") {
+    DynamicJsonDocument doc2(4096);
+    deserializeJson(doc, "{\"a\":[1,2,3]}");
+    doc2.set(doc);
+
+    REQUIRE(doc2.memoryUsage() ==
+            JSON_OBJECT_SIZE(1) + JSON_STRING_SIZE(2) + 3);
+    REQUIRE(doc.as<JsonVariant>() == doc2.as<JsonVariant>());
+
+    doc2["a"].as<JsonArray>();  // converts to slots
+    REQUIRE(doc.as<JsonVariant>() == doc2.as<JsonVariant>());
+
+    doc2["a"][2] = 4;
+    REQUIRE(doc.as<JsonVariant>() != doc2.as<JsonVariant>());
+  }
+
+  SECTION("copyArray() from a C array") {
+    int16_t src[] = {1, 2, 3};
+    REQUIRE(copyArray(src, doc));
+
+    REQUIRE(doc.memoryUsage() == sizeof(src));
+    REQUIRE(doc.as<std::string>() == "[1,2,3]");
+  }
+
+  SECTION("copyArray() to a C array of the same type") {
+    int8_t dst[4];
+    deserializeJson(doc, "[1,2,3]");
+
+    REQUIRE(copyArray(doc, dst) == 3);
+    REQUIRE(dst[0] == 1);
+    REQUIRE(dst[2] == 3);
+  }
+
+  SECTION("copyArray() to a C array of another type") {
+    double dst[2];
+    deserializeJson(doc, "[1,2,3]");
+
+    REQUIRE(copyArray(doc, dst) == 2);
+    REQUIRE(dst[0] == 1.0);
+    REQUIRE(dst[1] == 2.0);
+  }
+
+  SECTION("measureDeserializeJson() counts slots") {
+    const char* json = "[1,2,3,\"a\"]";
+    DynamicJsonDocument small(measureDeserializeJson(json));
+
+    REQUIRE(deserializeJson(small, json) == DeserializationError::Ok);
+  }
+
+  SECTION("shrinkToFit()") {
+    deserializeJson(doc, "{\"a\":[1,2,3],\"b\":[1000,2000]}");
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(doc.capacity() < 4096);
+    std::string json;
+    serializeJson(doc, json);
+    REQUIRE(json == "{\"a\":[1,2,3],\"b\":[1000,2000]}");
+  }
+}
@@ -0,0 +1,18 @@
+#define ARDUINOJSON_STRING_INTERNING 0
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_STRING_INTERNING == 0") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("deserializeJson() duplicates keys") {
+    deserializeJson(doc, "[{\"id\":1},{\"id\":2}]");
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + 2 * JSON_OBJECT_SIZE(1) +
+                                     2 * JSON_STRING_SIZE(3));
+    REQUIRE(doc[0].as<JsonObject>().begin()->key().c_str() !=
+            doc[1].as<JsonObject>().begin()->key().c_str());
+  }
+}
@@ -0,0 +1,91 @@
+#define ARDUINOJSON_STRING_INTERNING 1
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+static const char* keyOf(JsonVariant var) {
+  return var.as<JsonObject>().begin()->key().c_str();
+}
+
+TEST_CASE("ARDUINOJSON_STRING_INTERNING == 1") {
+  DynamicJsonDocument doc(16384);
+
+  SECTION("deserializeJson() shares identical keys") {
+    deserializeJson(doc, "[{\"id\":\"abc\"},{\"id\":\"abc\"},{\"id\":\"abc\"}]");
+
+    REQUIRE(keyOf(doc[0]) == keyOf(doc[1]));
+    REQUIRE(keyOf(doc[0]) == keyOf(doc[2]));
+    REQUIRE(doc[0]["id"].as<const char*>() != doc[1]["id"].as<const char*>());
+  }
+
+  SECTION("deserializeMsgPack() shares identical keys") {
+    const char input[] = "\x92\x81\xA2id\x01\x81\xA2id\x02";
+    deserializeMsgPack(doc, input, sizeof(input) - 1);
+
+    REQUIRE(keyOf(doc[0]) == keyOf(doc[1]));
+  }
+
+  SECTION("operator[] shares identical keys") {
+    doc.createNestedObject()[std::string("timestamp")] = 1;
+    doc.createNestedObject()[std::string("timestamp")] = 2;
+
+    REQUIRE(keyOf(doc[0]) == keyOf(doc[1]));
+  }
+
+  SECTION("reduces the memory usage") {
+    std::string json = "[";
+    for (int i = 0; i < 20; i++) json += "{\"timestamp\":0},";
+    json += "{\"timestamp\":0}]";
+    deserializeJson(doc, json);
+
+    REQUIRE(doc.size() == 21);
+    REQUIRE(doc.memoryUsage() < JSON_ARRAY_SIZE(21) +
+                                    21 * JSON_OBJECT_SIZE(1) +
+                                    21 * JSON_STRING_SIZE(10));
+  }
+
+  SECTION("gives back every duplicate key") {
+    deserializeJson(doc, "[{\"name\":1},{\"name\":2},{\"name\":3}]");
+
+    // one copy of the key, 8 buckets and one node
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(3) +
+                                     3 * JSON_OBJECT_SIZE(1) +
+                                     JSON_STRING_SIZE(5) + 10 * sizeof(char*));
+  }
+
+  SECTION("still works after the table grows") {
+    JsonObject obj0 = doc.createNestedObject();
+    JsonObject obj1 = doc.createNestedObject();
+    for (int i = 0; i < 100; i++) {
+      std::string key = "key" + std::to_string(i);
+      obj0[key] = i;
+      obj1[key] = i;
+    }
+
+    REQUIRE(obj1.size() == 100);
+    JsonObject::iterator it0 = obj0.begin();
+    JsonObject::iterator it1 = obj1.begin();
+    for (; it0 != obj0.end(); ++it0, ++it1) {
+      REQUIRE(it0->key().c_str() == it1->key().c_str());
+    }
+    REQUIRE(doc[1]["key99"] == 99);
+  }
+
+  SECTION("doesn't intern strings from a writable input") {
+    char input[] = "[{\"id\":1},{\"id\":2}]";
+    deserializeJson(doc, input);
+
+    REQUIRE(doc.memoryUsage() == JSON_ARRAY_SIZE(2) + 2 * JSON_OBJECT_SIZE(1));
+  }
+
+  SECTION("shrinkToFit() keeps room for the table") {
+    deserializeJson(doc, "[{\"name\":1},{\"name\":2}]");
+
+    REQUIRE(doc.shrinkToFit() == true);
+
+    REQUIRE(doc.capacity() < 16384);
+    REQUIRE(keyOf(doc[0]) == keyOf(doc[1]));
+    REQUIRE(doc[1]["name"] == 2);
+  }
+}
@@ -0,0 +1,37 @@
+#define ARDUINOJSON_STRING_INTERNING 2
+#include <ArduinoJson.h>
+
+#include <catch.hpp>
+#include <string>
+
+TEST_CASE("ARDUINOJSON_STRING_INTERNING == 2") {
+  DynamicJsonDocument doc(4096);
+
+  SECTION("deserializeJson() shares identical values") {
+    deserializeJson(doc, "[\"ok\",\"ok\",\"error\"]");
+
+    REQUIRE(doc[0].as<const char*>() == doc[1].as<const char*>());
+    REQUIRE(doc[0].as<const char*>() != doc[2].as<const char*>());
+  }
+
+  SECTION("set() shares identical values") {
+    doc.add(std::string("hello"));
+    doc.add(std::string("hello"));
+
+    REQUIRE(doc[0].as<const char*>() == doc[1].as<const char*>());
+  }
+
+  SECTION("a value can share a key") {
+    doc[std::string("hello")] = std::string("hello");
+
+    JsonObject obj = doc.as<JsonObject>();
+    REQUIRE(obj.begin()->key().c_str() == obj.begin()->value().as<char*>());
+  }
+
+  SECTION("measureDeserializeJson() leaves room for the table") {
+    const char* json = "{\"a\":\"x\",\"b\":\"y\",\"c\":\"a\"}";
+    DynamicJsonDocument small(measureDeserializeJson(json));
+
+    REQUIRE(deserializeJson(small, json) == DeserializationError::Ok);
+  }
+}
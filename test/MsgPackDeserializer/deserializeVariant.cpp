@@ -144,3 +144,17 @@ TEST_CASE("deserialize MsgPack value") {
     check<const char*>("\xdb\x00\x00\x00\x05hello", std::string("hello"));
   }
 }
+
+TEST_CASE("deserialize MsgPack string with an embedded NUL") {
+  DynamicJsonDocument doc(4096);
+  const char input[] = "\xA3" "a\0b";
+
+  DeserializationError error = deserializeMsgPack(doc, input, 4);
+
+  REQUIRE(error == DeserializationError::Ok);
+  REQUIRE(doc.memoryUsage() == JSON_STRING_SIZE(4));
+
+  std::string output;
+  serializeMsgPack(doc, output);
+  REQUIRE(output == std::string(input, 4));
+}
@@ -45,6 +45,24 @@ TEST_CASE("deserializeMsgPack(const std::string&)") {
   }
 }
 
+TEST_CASE("deserializeMsgPack(char*, size_t) with a writable buffer") {
+  DynamicJsonDocument doc(4096);
+  std::string input("\x81\xA5hello\xA5world");
+
+  DeserializationError err = deserializeMsgPack(doc, &input[0], input.size());
+
+  REQUIRE(err == DeserializationError::Ok);
+  REQUIRE(doc["hello"] == std::string("world"));
+
+  SECTION("strings are stored in the buffer, instead of the pool") {
+    const char* value = doc["hello"];
+
+    REQUIRE(input.data() <= value);
+    REQUIRE(value < input.data() + input.size());
+    REQUIRE(doc.memoryUsage() == JSON_OBJECT_SIZE(1));
+  }
+}
+
 TEST_CASE("deserializeMsgPack(std::istream&)") {
   DynamicJsonDocument doc(4096);
 
@@ -66,6 +84,25 @@ TEST_CASE("deserializeMsgPack(std::istream&)") {
 
     REQUIRE(err == DeserializationError::IncompleteInput);
   }
+
+  SECTION("should read a string longer than the read buffer") {
+    std::string value(100, 'x');
+    std::istringstream input("\xD9\x64" + value + "\xC3");
+
+    DeserializationError err = deserializeMsgPack(doc, input);
+
+    REQUIRE(err == DeserializationError::Ok);
+    REQUIRE(doc.as<std::string>() == value);
+    REQUIRE(input.get() == 0xC3);
+  }
+
+  SECTION("should detect a truncated string") {
+    std::istringstream input("\xD9\x64" + std::string(99, 'x'));
+
+    DeserializationError err = deserializeMsgPack(doc, input);
+
+    REQUIRE(err == DeserializationError::IncompleteInput);
+  }
 }
 
 #ifdef HAS_VARIABLE_LENGTH_ARRAY
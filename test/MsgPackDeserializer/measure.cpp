@@ -0,0 +1,63 @@
+// ArduinoJson - arduinojson.org
+// Copyright Benoit Blanchon 2014-2019
+// MIT License
+
+#include <ArduinoJson.h>
+#include <catch.hpp>
+
+static void checkMeasure(const std::string& input, size_t expected) {
+  size_t capacity = measureDeserializeMsgPack(input);
+  REQUIRE(capacity == expected);
+
+  DynamicJsonDocument doc(capacity);
+  REQUIRE(deserializeMsgPack(doc, input) == DeserializationError::Ok);
+  REQUIRE(doc.memoryUsage() == capacity);
+}
+
+TEST_CASE("measureDeserializeMsgPack()") {
+  SECTION("integer") {
+    checkMeasure(std::string("\xCD\x01\x02", 3), 0);
+  }
+
+  SECTION("fixstr") {
+    checkMeasure("\xA5hello", JSON_STRING_SIZE(6));
+  }
+
+  SECTION("str 8") {
+    checkMeasure("\xD9\x05hello", JSON_STRING_SIZE(6));
+  }
+
+  SECTION("fixarray") {
+    checkMeasure(std::string("\x93\x01\xCB\x40\x09\x21\xFB\x54\x44\x2D\x18"
+                             "\xA2hi",
+                             14),
+                 JSON_ARRAY_SIZE(3) + JSON_STRING_SIZE(3));
+  }
+
+  SECTION("array 16") {
+    checkMeasure(std::string("\xDC\x00\x02\xC0\xC3", 5), JSON_ARRAY_SIZE(2));
+  }
+
+  SECTION("fixmap") {
+    checkMeasure(std::string("\x82\xA3one\x01\xD9\x03two\x91\x02", 13),
+                 JSON_OBJECT_SIZE(2) + 2 * JSON_STRING_SIZE(4) +
+                     JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("stops at the end of the input") {
+    REQUIRE(measureDeserializeMsgPack("\x92\xA2hi\xA5he", 7) ==
+            JSON_ARRAY_SIZE(2) + JSON_STRING_SIZE(3));
+  }
+
+  SECTION("const char* with size") {
+    REQUIRE(measureDeserializeMsgPack("\x91\x01\x02", 2) == JSON_ARRAY_SIZE(1));
+  }
+
+  SECTION("deserializeMsgPack() reports the error") {
+    const char input[] = "\x92\xA5hello\xC1";  // 0xC1 is never used
+    DynamicJsonDocument doc(measureDeserializeMsgPack(input));
+
+    REQUIRE(deserializeMsgPack(doc, input) ==
+            DeserializationError::NotSupported);
+  }
+}